@@ -14,6 +14,7 @@ auto f_auto(int &x) { return x; }
 int constinit x = 1 + 2;
 
 auto variables_definitions() -> void {
+  TRACE_FUNCTION();
 
   {
     int v1 = 0; // C-like initialization
@@ -81,6 +82,7 @@ auto variables_definitions() -> void {
 // Values
 
 auto values() -> void {
+  TRACE_FUNCTION();
   {
     // Binary numbers
     int x{0b11};
@@ -139,6 +141,7 @@ auto values() -> void {
 // _____________________________________________________________________________
 
 auto enums() -> void {
+  TRACE_FUNCTION();
   {
     enum class Day {
       sunday = 7,
@@ -188,6 +191,7 @@ auto enums() -> void {
 // _____________________________________________________________________________
 
 auto strings() -> void {
+  TRACE_FUNCTION();
   std::string s0{"123"
                  "abc"};
   assert(s0 == "123abc");
@@ -207,6 +211,7 @@ auto strings() -> void {
 // _____________________________________________________________________________
 
 auto pointers_references() -> void {
+  TRACE_FUNCTION();
 
   struct AStruct {
     int int_value;
@@ -324,6 +329,23 @@ auto pointers_references() -> void {
   }
 }
 
+// _____________________________________________________________________________
+// Benchmarks
+
+auto bench_make_unique(runtime::State &state) -> void {
+  for (auto _ : state) {
+    auto p{std::make_unique<int>(10)};
+    runtime::do_not_optimize(p);
+  }
+}
+
+auto bench_make_shared(runtime::State &state) -> void {
+  for (auto _ : state) {
+    auto p{std::make_shared<int>(10)};
+    runtime::do_not_optimize(p);
+  }
+}
+
 // _____________________________________________________________________________
 
 auto run() -> void {
@@ -334,4 +356,11 @@ auto run() -> void {
   pointers_references();
 }
 
+runtime::ModuleRegistrar const registrar{"values_types", run};
+
+runtime::BenchmarkRegistrar const benchmarks[]{
+    {"values_types::make_unique", bench_make_unique},
+    {"values_types::make_shared", bench_make_shared},
+};
+
 } // namespace values_types
@@ -25,6 +25,7 @@ auto call_by_rvalue_reference(std::string &&x) -> std::string {
 }
 
 auto pass_parameters() -> void {
+  TRACE_FUNCTION();
   {
     // By lvalue reference
 
@@ -90,6 +91,7 @@ auto constexpr_consteval_test(int x) -> void {
 // Lambda
 
 auto lambdas() -> void {
+  TRACE_FUNCTION();
 
   {
     auto reference_sum{0};     // Capturing value by reference
@@ -150,6 +152,31 @@ auto lambdas() -> void {
     assert(functionPointer(12) == 12);
   }
 }
+// _____________________________________________________________________________
+// Benchmarks
+
+auto bench_lambda_call(runtime::State &state) -> void {
+  auto value{1};
+  auto lambda = [value](int x) -> int { return x + value; };
+  auto x{0};
+  for (auto _ : state) {
+    runtime::do_not_optimize(x);
+    x = lambda(x);
+  }
+}
+
+auto bench_std_function_call(runtime::State &state) -> void {
+  auto value{1};
+  std::function<int(int)> function = [value](int x) -> int {
+    return x + value;
+  };
+  auto x{0};
+  for (auto _ : state) {
+    runtime::do_not_optimize(x);
+    x = function(x);
+  }
+}
+
 // _____________________________________________________________________________
 
 auto run() -> void {
@@ -170,4 +197,11 @@ auto run() -> void {
   lambdas();
 }
 
+runtime::ModuleRegistrar const registrar{"functions", run};
+
+runtime::BenchmarkRegistrar const benchmarks[]{
+    {"functions::lambda_call", bench_lambda_call},
+    {"functions::std_function_call", bench_std_function_call},
+};
+
 } // namespace functions
@@ -27,6 +27,7 @@ auto bar(Value x) -> int { return x.value; } // declaration & definition
 } // namespace foo
 
 auto namespace_members() -> void {
+  TRACE_FUNCTION();
   assert(foo::something(1) == 1);
   assert(foo::bar({1}) == 1);
 
@@ -40,6 +41,7 @@ auto namespace_members() -> void {
 }
 
 auto argument_dependent_lookup() -> void {
+  TRACE_FUNCTION();
   // ADL Argument-dependent lookup
   // If a function is not found in the context of its use, we look in the
   // namespaces of its arguments
@@ -51,6 +53,7 @@ auto argument_dependent_lookup() -> void {
 // Namespace aliases
 
 auto namespace_aliases() -> void {
+  TRACE_FUNCTION();
   namespace newName = foo;
   newName::value = 300;
   assert(foo::value == 300);
@@ -65,7 +68,10 @@ namespace {
 auto foobaz() -> int { return 1; }
 } // namespace
 
-auto unnamed_namespaces() -> void { assert(foobaz() == 1); }
+auto unnamed_namespaces() -> void {
+  TRACE_FUNCTION();
+  assert(foobaz() == 1);
+}
 
 // _____________________________________________________________________________
 // Nested namespace
@@ -94,6 +100,7 @@ auto f(int x) -> int { return x + 1; };
 } // namespace MyLib
 
 auto versioning() -> void {
+  TRACE_FUNCTION();
   assert(MyLib::f(1, 2) == 3);
   assert(MyLib::V1::f(1) == 2);
 }
@@ -102,6 +109,7 @@ auto versioning() -> void {
 // Using directive does not add a name to a local scope
 
 auto using_directive() -> void {
+  TRACE_FUNCTION();
   value = 1; // global value
 
   using namespace foo;
@@ -118,6 +126,7 @@ auto using_directive() -> void {
 // Using declaration add a name to a local scope
 
 auto using_declaration() -> void {
+  TRACE_FUNCTION();
   using foo::something;
 
   value = 1;        // global value
@@ -140,6 +149,7 @@ auto bar() -> int { return 0; }
 } // namespace baz
 
 auto namespace_composition() -> void {
+  TRACE_FUNCTION();
   assert(baz::bar() == 0);
   assert(baz::something(10) == 10);
   baz::string s{"Hello world"};
@@ -170,6 +180,7 @@ auto g(int x) -> std::string { return "g_int"; }
 auto g(double x) -> std::string { return "g_double"; }
 
 auto overloading_func() -> void {
+  TRACE_FUNCTION();
   overloading::overloading_in_namespace();
   auto double_value = 12.90;
   auto int_value = 12;
@@ -208,4 +219,6 @@ auto run() -> void {
   overloading_func();
 }
 
+runtime::ModuleRegistrar const registrar{"namespaces", run};
+
 } // namespace namespaces
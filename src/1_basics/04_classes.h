@@ -66,12 +66,13 @@ public:
       : _value{instance._value ? new int{*instance._value} : nullptr} {}
 
   // Move constructor
-  MoveAndCopyClass(MoveAndCopyClass &&instance) : MoveAndCopyClass{} {
+  // noexcept: containers move instead of copying only if it cannot throw
+  MoveAndCopyClass(MoveAndCopyClass &&instance) noexcept : MoveAndCopyClass{} {
     this->swap(instance);
   }
 
   // Assignment
-  MoveAndCopyClass &operator=(MoveAndCopyClass instance) {
+  MoveAndCopyClass &operator=(MoveAndCopyClass instance) noexcept {
     this->swap(instance);
     return *this;
   }
@@ -102,12 +103,12 @@ public:
   ~MoveOnlyClass() { delete _value; }
 
   // Move constructor
-  MoveOnlyClass(MoveOnlyClass &&instance) : MoveOnlyClass() {
+  MoveOnlyClass(MoveOnlyClass &&instance) noexcept : MoveOnlyClass() {
     this->swap(instance);
   }
 
   // Move assignment
-  MoveOnlyClass &operator=(MoveOnlyClass &&instance) {
+  MoveOnlyClass &operator=(MoveOnlyClass &&instance) noexcept {
     this->swap(instance);
     return *this;
   }
@@ -130,6 +131,8 @@ private:
   int _value{};
 
   // Mutable mean that it can be modified even in const object
+  // A plain mutable int is a data race if two threads call value() on a shared
+  // object: see logical_constness::MutableStat
   mutable int _logical_constness{};
 
 public:
@@ -24,6 +24,26 @@ public:
 
 class A {};
 
+// _____________________________________________________________________________
+// Benchmarks
+
+auto bench_copy(runtime::State &state) -> void {
+  MoveAndCopyClass x{10};
+  for (auto _ : state) {
+    MoveAndCopyClass y{x};
+    runtime::do_not_optimize(y);
+  }
+}
+
+auto bench_move(runtime::State &state) -> void {
+  MoveAndCopyClass x{10};
+  for (auto _ : state) {
+    MoveAndCopyClass y{std::move(x)};
+    x = std::move(y);
+    runtime::do_not_optimize(x);
+  }
+}
+
 // _____________________________________________________________________________
 
 auto run() -> void {
@@ -47,4 +67,12 @@ auto run() -> void {
     // Z z{1}; // Error
   }
 }
+
+runtime::ModuleRegistrar const registrar{"classes", run};
+
+runtime::BenchmarkRegistrar const benchmarks[]{
+    {"classes::copy", bench_copy},
+    {"classes::move", bench_move},
+};
+
 } // namespace classes
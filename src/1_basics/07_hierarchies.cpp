@@ -7,6 +7,7 @@ namespace hierarchies {
 // Slicing
 
 auto slicing() -> void {
+  TRACE_FUNCTION();
   {
     class Base {
     public:
@@ -93,6 +94,7 @@ struct Derived2 : Base {
 };
 
 auto overloading() -> void {
+  TRACE_FUNCTION();
   overloading::Derived d{};
   assert(d.f(10.0) == "derived");
   assert(d.g(A{}) == "derived");
@@ -118,6 +120,7 @@ auto overloading() -> void {
 // Virtual inheritance
 
 auto virtual_inheritance() -> void {
+  TRACE_FUNCTION();
   /*
    Every virtual base of a derived class is represented by the same shared
    object. A virtual base is always considered a direct base of its most derived
@@ -188,6 +191,38 @@ auto virtual_inheritance() -> void {
   assert(c.B::foo() == "B");
 }
 
+// ____________________________________________________________________________
+// Benchmarks
+
+struct Shape {
+  virtual ~Shape() = default;
+  virtual auto area() const -> int { return 0; }
+};
+
+struct Square : Shape {
+  int side{3};
+  auto area() const -> int override { return side * side; }
+};
+
+auto bench_virtual_call(runtime::State &state) -> void {
+  Square square{};
+  Shape *shape{&square};
+  for (auto _ : state) {
+    runtime::do_not_optimize(shape);
+    runtime::do_not_optimize(shape->area());
+  }
+}
+
+auto bench_qualified_call(runtime::State &state) -> void {
+  Square square{};
+  Square *shape{&square};
+  for (auto _ : state) {
+    runtime::do_not_optimize(shape);
+    // Explicit qualification: no virtual dispatch
+    runtime::do_not_optimize(shape->Square::area());
+  }
+}
+
 // ____________________________________________________________________________
 
 auto run() -> void {
@@ -196,4 +231,11 @@ auto run() -> void {
   virtual_inheritance();
 }
 
+runtime::ModuleRegistrar const registrar{"hierarchies", run};
+
+runtime::BenchmarkRegistrar const benchmarks[]{
+    {"hierarchies::virtual_call", bench_virtual_call},
+    {"hierarchies::qualified_call", bench_qualified_call},
+};
+
 } // namespace hierarchies
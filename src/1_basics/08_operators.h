@@ -0,0 +1,121 @@
+#ifndef operators_h
+#define operators_h
+
+#include <compare>
+#include <istream>
+#include <ostream>
+
+namespace operators {
+
+// _____________________________________________________________________________
+// Operators as members functions
+
+// Throws std::out_of_range. Out of line and cold, as
+// bounds_check::out_of_range: operator[] keeps a compare and a branch
+[[noreturn, gnu::cold]] auto index_out_of_range(int index) -> void;
+
+class Vector {
+
+public:
+  int x, y;
+
+  Vector(int x, int y) : x{x}, y{y} {}
+
+  //  Operators as members functions
+  auto operator&() -> Vector & = delete;
+
+  auto operator=(Vector const &rhs) -> Vector & {
+    x = rhs.x;
+    y = rhs.y;
+    return *this;
+  }
+
+  // prefix
+  auto operator++() -> Vector & {
+    x += 1;
+    y += 1;
+    return *this;
+  }
+
+  // postfix (dummy argument)
+  auto operator++(int) -> Vector {
+    auto old{*this};
+    x += 1;
+    y += 1;
+    return old;
+  }
+
+  // One unsigned comparison covers the negative indices too, and the
+  // selection of the member compiles to a conditional move
+  auto operator[](int index) const -> int {
+    if (static_cast<unsigned>(index) > 1) {
+      index_out_of_range(index);
+    }
+    return index == 0 ? x : y;
+  }
+
+  auto operator[](int index) -> int & {
+    if (static_cast<unsigned>(index) > 1) {
+      index_out_of_range(index);
+    }
+    return index == 0 ? x : y;
+  }
+};
+
+// _____________________________________________________________________________
+// Operators as free-standing functions
+// To give identical treatment to both operands of a binary operator,
+// it is best defined as a free-standing function in the namespace of its class
+
+inline auto operator+=(Vector &lhs, Vector const &rhs) -> Vector & {
+  lhs.x += rhs.x;
+  lhs.y += rhs.y;
+  return lhs;
+}
+
+inline auto operator+(Vector const &lhs, Vector const &rhs) -> Vector {
+  auto vector{lhs};
+  vector += rhs;
+  return vector;
+}
+
+inline auto operator<<(std::ostream &os, Vector &src) -> std::ostream & {
+  os << src.x << " " << src.y;
+  return os;
+}
+
+inline auto operator>>(std::istream &is, Vector &src) -> std::istream & {
+  is >> src.x >> src.y;
+  return is;
+}
+
+inline auto operator==(const Vector &lhs, Vector const &rhs) -> int {
+  return lhs.x == rhs.x && lhs.y == rhs.y;
+}
+
+// Lexicographic: by x, then by y. A strong ordering, as the one of int, so
+// <, <=, > and >= are rewritten in terms of it and Vector can be sorted
+inline auto operator<=>(const Vector &lhs, Vector const &rhs)
+    -> std::strong_ordering {
+  if (auto const order{lhs.x <=> rhs.x}; order != 0) {
+    return order;
+  }
+  return lhs.y <=> rhs.y;
+}
+
+// _____________________________________________________________________________
+// Function object
+
+class Incrementer {
+  int _value;
+
+public:
+  Incrementer(int value) : _value{value} {}
+
+  // Call operator also known as the application operator
+  auto operator()(int x) const -> int { return x + _value; }
+};
+
+} // namespace operators
+
+#endif
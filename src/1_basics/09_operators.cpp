@@ -1,6 +1,9 @@
 #include "../header.h"
+#include "08_operators.h"
 #include <complex>
 #include <sstream>
+#include <stdexcept>
+#include <string>
 
 /*
  Overloadable operators
@@ -16,20 +19,16 @@
 
 namespace operators {
 
+auto index_out_of_range(int index) -> void {
+  throw std::out_of_range{"index " + std::to_string(index) +
+                          " out of range for size 2"};
+}
+
 // _____________________________________________________________________________
 // Function object
 
-class Incrementer {
-  int _value;
-
-public:
-  Incrementer(int value) : _value{value} {}
-
-  // Call operator also known as the application operator
-  auto operator()(int x) const -> int { return x + _value; }
-};
-
 auto function_object() -> void {
+  TRACE_FUNCTION();
   Incrementer incrementer{2};
   assert(incrementer(10) == 12);
 }
@@ -56,6 +55,7 @@ constexpr auto operator""_m(unsigned long long m) -> Meter {
 }
 
 auto litterals() -> void {
+  TRACE_FUNCTION();
   {
     Meter meter{1};
     meter = 1_m; // litteral type
@@ -90,61 +90,8 @@ auto litterals() -> void {
 // _____________________________________________________________________________
 // Operators as members functions
 
-class Vector {
-
-public:
-  int x, y;
-
-  Vector(int x, int y) : x{x}, y{y} {}
-
-  //  Operators as members functions
-  auto operator&() -> Vector & = delete;
-
-  auto operator=(Vector const &rhs) -> Vector & {
-    x = rhs.x;
-    y = rhs.y;
-    return *this;
-  }
-
-  // prefix
-  auto operator++() -> Vector & {
-    x += 1;
-    y += 1;
-    return *this;
-  }
-
-  // postfix (dummy argument)
-  auto operator++(int) -> Vector {
-    auto old{*this};
-    x += 1;
-    y += 1;
-    return old;
-  }
-
-  auto operator[](int index) const -> int {
-    switch (index) {
-    case 0:
-      return x;
-    case 1:
-      return y;
-    default:
-      throw std::out_of_range("");
-    }
-  }
-
-  auto operator[](int index) -> int & {
-    switch (index) {
-    case 0:
-      return x;
-    case 1:
-      return y;
-    default:
-      throw std::out_of_range("");
-    }
-  }
-};
-
 auto member_operators() -> void {
+  TRACE_FUNCTION();
   {
     Vector v1{3, 1};
     Vector v2{v1};
@@ -187,48 +134,23 @@ auto member_operators() -> void {
     assert(v2[0] == 3 && v2[1] == 1);
     v2[0] = 10;
     assert(v2[0] == 10 && v2[1] == 1);
+
+    auto thrown{false};
+    try {
+      static_cast<void>(v1[-1]);
+    } catch (std::out_of_range const &error) {
+      thrown = true;
+      assert(std::string{error.what()} == "index -1 out of range for size 2");
+    }
+    assert(thrown);
   }
 }
 
 // _____________________________________________________________________________
 // Operators as free-standing functions
-// To give identical treatment to both operands of a binary operator,
-// it is best defined as a free-standing function in the namespace of its class
-
-auto operator+=(Vector &lhs, Vector const &rhs) -> Vector & {
-  lhs.x += rhs.x;
-  lhs.y += rhs.y;
-  return lhs;
-}
-
-auto operator+(Vector const &lhs, Vector const &rhs) -> Vector {
-  auto vector{lhs};
-  vector += rhs;
-  return vector;
-}
-
-auto operator<<(std::ostream &os, Vector &src) -> std::ostream & {
-  os << src.x << " " << src.y;
-  return os;
-}
-
-auto operator>>(std::istream &is, Vector &src) -> std::istream & {
-  is >> src.x >> src.y;
-  return is;
-}
-
-auto operator==(const Vector &lhs, Vector const &rhs) -> int {
-  return lhs.x == rhs.x && lhs.y == rhs.y;
-}
-
-auto operator<=>(const Vector &lhs, Vector const &rhs) -> int {
-  if (lhs == rhs) {
-    return 0;
-  }
-  return (lhs.x < rhs.x || lhs.y < rhs.y) ? -1 : 1;
-}
 
 auto non_member_operators() -> void {
+  TRACE_FUNCTION();
   {
     Vector v1{3, 1};
     Vector v2{3, 1};
@@ -265,11 +187,35 @@ auto non_member_operators() -> void {
   }
 
   {
-    assert((Vector{3, 1} <=> Vector{3, 2}) == -1);
+    assert((Vector{3, 1} <=> Vector{3, 2}) < 0);
+    assert((Vector{3, 1} <=> Vector{3, 1}) == std::strong_ordering::equal);
+    assert((Vector{2, 5} < Vector{3, 1}));
     assert((Vector{3, 1} == Vector{3, 1}));
   }
 }
 
+// _____________________________________________________________________________
+// Benchmarks
+
+auto bench_vector_add(runtime::State &state) -> void {
+  Vector v{0, 0};
+  Vector const one{1, 1};
+  for (auto _ : state) {
+    v += one;
+    runtime::do_not_optimize(v);
+  }
+}
+
+auto bench_vector_index(runtime::State &state) -> void {
+  Vector v{3, 1};
+  auto index{0};
+  for (auto _ : state) {
+    runtime::do_not_optimize(index);
+    runtime::do_not_optimize(v[index & 1]);
+    ++index;
+  }
+}
+
 // _____________________________________________________________________________
 
 auto run() -> void {
@@ -279,4 +225,11 @@ auto run() -> void {
   non_member_operators();
 }
 
+runtime::ModuleRegistrar const registrar{"operators", run};
+
+runtime::BenchmarkRegistrar const benchmarks[]{
+    {"operators::vector_add", bench_vector_add},
+    {"operators::vector_index", bench_vector_index},
+};
+
 } // namespace operators
@@ -1,4 +1,5 @@
 #include "../header.h"
+#include <utility>
 
 namespace exceptions {
 
@@ -7,7 +8,7 @@ namespace exceptions {
 
 class CustomException final : public std::exception {
 public:
-  CustomException(std::string message) : message{message} {}
+  CustomException(std::string message) : message{std::move(message)} {}
 
   auto what() const noexcept -> const char * override {
     return message.c_str();
@@ -43,6 +44,19 @@ auto function_try_block() -> void try {
 } catch (...) {
 }
 
+// _____________________________________________________________________________
+// Benchmarks
+
+auto bench_throw_catch(runtime::State &state) -> void {
+  for (auto _ : state) {
+    try {
+      throwing_function();
+    } catch (CustomException &e) {
+      runtime::do_not_optimize(e);
+    }
+  }
+}
+
 // _____________________________________________________________________________
 
 auto run() -> void {
@@ -69,4 +83,10 @@ auto run() -> void {
   assert(throwed);
 }
 
+runtime::ModuleRegistrar const registrar{"exceptions", run};
+
+runtime::BenchmarkRegistrar const benchmarks[]{
+    {"exceptions::throw_catch", bench_throw_catch},
+};
+
 } // namespace exceptions
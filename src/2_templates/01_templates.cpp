@@ -73,6 +73,7 @@ template <typename T> auto template_class_utility(T const &y) {
 }
 
 auto template_class() -> void {
+  TRACE_FUNCTION();
   TemplateClass<int> x1{0};
   TemplateClass x2{0};
 
@@ -117,6 +118,7 @@ struct TemplateParameters {
 };
 
 auto template_parameters() -> void {
+  TRACE_FUNCTION();
   auto cmp{[](int const &, int const &) -> bool { return false; }};
 
   TemplateParameters</* T = */ int, /* Compare = */ std::greater<int>,
@@ -176,6 +178,7 @@ public:
 };
 
 auto user_defined_specialization() -> void {
+  TRACE_FUNCTION();
   {
     Vector<int> v{2};
     v[0] = 0;
@@ -219,6 +222,7 @@ auto default_value(int /* dummy argument*/) -> int { return 0; }
 auto default_value(char /* dummy argument*/) -> char { return 'a'; }
 
 auto function_template() -> void {
+  TRACE_FUNCTION();
   // Function template
   auto result{increment<float, 2>(10)};
   assert(result == 12);
@@ -256,6 +260,7 @@ template <typename T> constexpr T pi = 3.141592653589793238462643383;
 template <> constexpr char const *pi<char const *>{"pi"};
 
 auto variable_templates() -> void {
+  TRACE_FUNCTION();
   assert(pi<int> == 3);
   assert(std::string{pi<const char *>} == "pi");
   assert(pi<double> > 3.14 || pi<double> < 3.15);
@@ -278,6 +283,7 @@ struct {
 } lambda1{};
 
 auto generic_lambdas() -> void {
+  TRACE_FUNCTION();
   auto lambda = []<typename T, typename U>(T x, U y) { return x + y; };
 
   assert(lambda(1, 2) == 3);
@@ -337,6 +343,7 @@ public:
 };
 
 auto variadic_templates() -> void {
+  TRACE_FUNCTION();
   assert(variadic_function_sum(1, 2, 3) == 6);
 
   assert(fold_expression_unary_left_div(18, 2, 3) == 3);
@@ -374,6 +381,7 @@ template <typename T> auto sfinae(T &x) -> typename T::value_type & {
 }
 
 auto substitution_failure_is_not_an_error() -> void {
+  TRACE_FUNCTION();
   std::vector<int> a{11};
   assert(sfinae(a) == 11);
 
@@ -392,7 +400,10 @@ template <typename T1, typename T2> struct Simple_Pair {
 // User-defined deduction guide
 template <typename T1, typename T2> Simple_Pair(T1, T2) -> Simple_Pair<T1, T2>;
 
-auto deduction_guide() { Simple_Pair s{1, 2}; }
+auto deduction_guide() {
+  TRACE_FUNCTION();
+  Simple_Pair s{1, 2};
+}
 
 // _____________________________________________________________________________
 // Template Argument Deduction
@@ -409,6 +420,7 @@ template <typename T> auto template_argument_deduction(T &&x) {
 }
 
 auto template_argument_deduction_test() -> void {
+  TRACE_FUNCTION();
   auto x{1};
   template_argument_deduction(x); // T = &int -> T&& = int&
   assert(x == 2);
@@ -450,6 +462,7 @@ template <class T> auto forwarding(T &&x) -> std::string {
 }
 
 auto forwarding_test() -> void {
+  TRACE_FUNCTION();
   std::string x{"Hello"};
   assert(forwarding(x) == "lvalue");
   assert(forwarding(std::string{"world"}) == "rvalue");
@@ -459,6 +472,7 @@ auto forwarding_test() -> void {
 // Manual Control Instantiation
 
 auto manual_control_instantiation() -> void {
+  TRACE_FUNCTION();
   namespace mci = manual_control_instantiation;
 
   mci::MCI_Class<bool> x{};
@@ -482,6 +496,7 @@ struct SuperBase {
 struct DerivedCRTP : public BaseCRTP<DerivedCRTP, SuperBase> {};
 
 auto crtp() -> void {
+  TRACE_FUNCTION();
   DerivedCRTP x{};
   assert(x.bar(x) == 10);
 }
@@ -527,6 +542,7 @@ public:
 };
 
 auto concepts() -> void {
+  TRACE_FUNCTION();
   A a{};
   func_with_concept_1(&a);
   func_with_concept_1(&a);
@@ -552,4 +568,6 @@ auto run() -> void {
   concepts();
 }
 
+runtime::ModuleRegistrar const registrar{"templates", run};
+
 } // namespace templates
@@ -36,6 +36,7 @@ constexpr int factorial_constexpr_func(int i) {
 // -----------------------------------------------------------------------------
 
 auto recursion() -> void {
+  TRACE_FUNCTION();
   assert(factorial_template_class<3>::value == 6);
   assert(factorial_template_class_v<3> == 6);
   assert(factorial_template_func<3>() == 6);
@@ -66,6 +67,7 @@ struct Decrementer {
 };
 
 auto conditional_test() -> void {
+  TRACE_FUNCTION();
   std::conditional_t<true, Incrementer, Decrementer> z{};
   assert(z(1) == 2);
 }
@@ -87,6 +89,7 @@ template <unsigned N, typename... Cases>
 using select_t = typename select<N, Cases...>::type;
 
 auto selecting_test() -> void {
+  TRACE_FUNCTION();
   select_t<1, Incrementer, Decrementer, int> z{};
   assert(z(1) == 0);
 }
@@ -126,6 +129,7 @@ template <typename T> struct StructWithEnable_if {
 };
 
 auto enable_if_test() -> void {
+  TRACE_FUNCTION();
   {
     StructWithEnable_if<int> x{};
     // StructWithEnable_if<int> y{1}; // Error
@@ -166,6 +170,7 @@ template <typename T> auto set_value(T &x, value_trait_v<T> value) -> void {
 }
 
 auto trait_test() -> void {
+  TRACE_FUNCTION();
   B b{};
   set_value(b, "Hello");
   assert(b.value == "Hello");
@@ -181,4 +186,6 @@ auto run() -> void {
   trait_test();
 }
 
+runtime::ModuleRegistrar const registrar{"metaprogramming", run};
+
 } // namespace metaprogramming
@@ -8,6 +8,7 @@
 // Call C from C++
 
 auto call_c_from_cpp() -> void {
+  TRACE_FUNCTION();
   assert(clib::sum(1, 2) == 3);
   assert(std::strcmp("ABC", "abc") == -1);
 
@@ -19,6 +20,7 @@ auto call_c_from_cpp() -> void {
 // Call C++ from C
 
 auto call_cpp_from_c() -> void {
+  TRACE_FUNCTION();
   NLPersonRef person{NLPersonCreate("Name1")};
   {
     char *name{NLPersonGetName(person)};
@@ -57,9 +59,38 @@ int interoperability_x2{0};               // definition
 
 namespace interoperability {
 
+// _____________________________________________________________________________
+// Benchmarks
+
+auto bench_c_handle(runtime::State &state) -> void {
+  for (auto _ : state) {
+    auto fooPointer{clib::createFooSmartPointer(1)};
+    runtime::do_not_optimize(fooPointer);
+  }
+}
+
+auto bench_c_string_copy(runtime::State &state) -> void {
+  NLPersonRef person{NLPersonCreate("Name1")};
+  for (auto _ : state) {
+    char *name{NLPersonGetName(person)};
+    runtime::do_not_optimize(name);
+    NLStringDelete(name);
+  }
+  NLPersonDelete(person);
+}
+
+// _____________________________________________________________________________
+
 auto run() -> void {
   call_c_from_cpp();
   call_cpp_from_c();
 }
 
+runtime::ModuleRegistrar const registrar{"interoperability", run};
+
+runtime::BenchmarkRegistrar const benchmarks[]{
+    {"interoperability::c_handle", bench_c_handle},
+    {"interoperability::c_string_copy", bench_c_string_copy},
+};
+
 } // namespace interoperability
@@ -12,6 +12,27 @@ public:
 
 class Derived : public Base {};
 
+// _____________________________________________________________________________
+// Benchmarks
+
+auto bench_static_cast(runtime::State &state) -> void {
+  Derived derived{};
+  Base *base{&derived};
+  for (auto _ : state) {
+    runtime::do_not_optimize(base);
+    runtime::do_not_optimize(static_cast<Derived *>(base));
+  }
+}
+
+auto bench_dynamic_cast(runtime::State &state) -> void {
+  Derived derived{};
+  Base *base{&derived};
+  for (auto _ : state) {
+    runtime::do_not_optimize(base);
+    runtime::do_not_optimize(dynamic_cast<Derived *>(base));
+  }
+}
+
 // _____________________________________________________________________________
 
 auto run() -> void {
@@ -78,4 +99,11 @@ auto run() -> void {
   }
 }
 
+runtime::ModuleRegistrar const registrar{"casts", run};
+
+runtime::BenchmarkRegistrar const benchmarks[]{
+    {"casts::static_cast", bench_static_cast},
+    {"casts::dynamic_cast", bench_dynamic_cast},
+};
+
 } // namespace casts
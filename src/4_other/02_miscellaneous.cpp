@@ -26,6 +26,7 @@ template <class T, int N> auto f1(T (&r)[N]) {}
 auto f2(int (&r)[10]) {}
 
 auto references_to_arrays() -> void {
+  TRACE_FUNCTION();
   int a10[10];
   int a11[11];
   f1(a10);
@@ -77,6 +78,7 @@ auto some_attributes() -> int {
 }
 
 auto attributes() -> void {
+  TRACE_FUNCTION();
   // nodiscard_function_1(); // Warning
   // nodiscard_function_2(); // Warning
   NodiscardStruct value{};
@@ -87,6 +89,7 @@ auto attributes() -> void {
 // Type Identification
 
 auto type_identification() -> void {
+  TRACE_FUNCTION();
   std::type_info const &type_info_string_1{typeid(std::string)};
   std::type_info const &type_info_string_2{typeid(std::string{"Hello"})};
   std::set<std::type_index> type_index{type_info_string_1};
@@ -106,6 +109,7 @@ auto foo(bool flag) -> std::optional<std::string> {
 }
 
 auto optional() -> void {
+  TRACE_FUNCTION();
   if (auto x{foo(true)}) {
     assert(x == "Hello");
   } else {
@@ -155,4 +159,6 @@ auto run() -> void {
   }
 }
 
+runtime::ModuleRegistrar const registrar{"miscellaneous", run};
+
 } // namespace miscellaneous
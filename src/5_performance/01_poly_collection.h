@@ -0,0 +1,160 @@
+#ifndef poly_collection_h
+#define poly_collection_h
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <typeindex>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+namespace poly_collection {
+
+// ____________________________________________________________________________
+// Polymorphic collection
+/*
+A vector<unique_ptr<Base>> stores every object in its own heap block: an
+iteration chases one pointer per element and jumps through a vtable whose
+target changes with the type of each element.
+
+PolyCollection<Base> stores the objects by value, in one contiguous segment
+per concrete type, and iterates segment by segment:
+- for_each(f) calls f(Base &): still a virtual call, but on contiguous memory
+  and with the same target for a whole segment, which the branch predictor
+  learns
+- for_each<Ts...>(f) restitutes the static type of the segments of Ts...,
+  f(T &) is instantiated for each of them: calls to members that are final
+  (or members of final classes) are resolved at compile time and inlined
+
+The order of insertion is only preserved within a segment
+*/
+
+template <typename Base> class PolyCollection {
+public:
+  // Constructs a T in the segment of T
+  template <std::derived_from<Base> T, typename... Args>
+  auto emplace(Args &&...args) -> T & {
+    return segment_of<T>().elements.emplace_back(std::forward<Args>(args)...);
+  }
+
+  template <std::derived_from<Base> T> auto insert(T value) -> T & {
+    return emplace<T>(std::move(value));
+  }
+
+  auto size() const -> std::size_t {
+    std::size_t size{0};
+    for (auto const &segment : _segments) {
+      size += segment->size();
+    }
+    return size;
+  }
+
+  auto empty() const -> bool { return size() == 0; }
+
+  // Elements of dynamic type T, contiguous
+  template <std::derived_from<Base> T> auto segment() -> std::span<T> {
+    if (auto segment{find<T>()}) {
+      return segment->elements;
+    }
+    return {};
+  }
+
+  template <std::derived_from<Base> T> auto reserve(std::size_t count) -> void {
+    segment_of<T>().elements.reserve(count);
+  }
+
+  // Calls f(Base &) on every element, segment by segment
+  template <typename F> auto for_each(F f) -> void {
+    for (auto &segment : _segments) {
+      segment->for_each(
+          [](void *function, Base &element) {
+            (*static_cast<F *>(function))(element);
+          },
+          &f);
+    }
+  }
+
+  // Calls f(T &) on the elements of the segments of Ts..., f(Base &) on the
+  // others
+  template <std::derived_from<Base>... Ts, typename F>
+    requires(sizeof...(Ts) > 0)
+  auto for_each(F f) -> void {
+    for (auto &segment : _segments) {
+      if (!(restitute<Ts>(*segment, f) || ...)) {
+        segment->for_each(
+            [](void *function, Base &element) {
+              (*static_cast<F *>(function))(element);
+            },
+            &f);
+      }
+    }
+  }
+
+private:
+  class SegmentBase {
+  public:
+    explicit SegmentBase(std::type_index type) : type{type} {}
+
+    virtual ~SegmentBase() = default;
+
+    virtual auto size() const -> std::size_t = 0;
+
+    // One indirect call per element, always to the same target
+    virtual auto for_each(auto (*call)(void *, Base &)->void, void *context)
+        -> void = 0;
+
+    std::type_index const type;
+  };
+
+  template <typename T> class Segment final : public SegmentBase {
+  public:
+    Segment() : SegmentBase{typeid(T)} {}
+
+    auto size() const -> std::size_t override { return elements.size(); }
+
+    auto for_each(auto (*call)(void *, Base &)->void, void *context)
+        -> void override {
+      for (auto &element : elements) {
+        call(context, element);
+      }
+    }
+
+    std::vector<T> elements{};
+  };
+
+  // Few segments: a linear search beats hashing
+  std::vector<std::unique_ptr<SegmentBase>> _segments{};
+
+  template <typename T> auto find() -> Segment<T> * {
+    auto const it{std::ranges::find(_segments, std::type_index{typeid(T)},
+                                    &SegmentBase::type)};
+    return it == _segments.end() ? nullptr
+                                 : static_cast<Segment<T> *>(it->get());
+  }
+
+  template <typename T> auto segment_of() -> Segment<T> & {
+    if (auto segment{find<T>()}) {
+      return *segment;
+    }
+    return static_cast<Segment<T> &>(
+        *_segments.emplace_back(std::make_unique<Segment<T>>()));
+  }
+
+  template <typename T, typename F>
+  static auto restitute(SegmentBase &segment, F &f) -> bool {
+    if (segment.type != typeid(T)) {
+      return false;
+    }
+    for (auto &element : static_cast<Segment<T> &>(segment).elements) {
+      f(element);
+    }
+    return true;
+  }
+};
+
+} // namespace poly_collection
+
+#endif
@@ -0,0 +1,173 @@
+#include "../header.h"
+#include "../1_basics/06_hierarchies.h"
+#include "01_poly_collection.h"
+#include <random>
+
+namespace poly_collection {
+
+// ____________________________________________________________________________
+// Segments
+
+auto segments() -> void {
+  TRACE_FUNCTION();
+  PolyCollection<hierarchies::AbstractClass> collection{};
+  collection.emplace<hierarchies::Derived>(true);
+  collection.emplace<hierarchies::FinalClass>();
+  collection.emplace<hierarchies::Derived>();
+
+  assert(collection.size() == 3);
+  assert(collection.segment<hierarchies::Derived>().size() == 2);
+  assert(collection.segment<hierarchies::FinalClass>().size() == 1);
+
+  // The elements are stored by value: no slicing, the dynamic type is kept
+  auto finals{0};
+  collection.for_each([&](hierarchies::AbstractClass &element) {
+    finals += dynamic_cast<hierarchies::FinalClass *>(&element) != nullptr;
+  });
+  assert(finals == 1);
+}
+
+// ____________________________________________________________________________
+// Type restitution
+
+struct Shape {
+  virtual ~Shape() = default;
+  virtual auto area() const -> long = 0;
+};
+
+struct Square final : Shape {
+  long side;
+  explicit Square(long side) : side{side} {}
+  auto area() const -> long override { return side * side; }
+};
+
+struct Rectangle final : Shape {
+  long width;
+  long height;
+  Rectangle(long width, long height) : width{width}, height{height} {}
+  auto area() const -> long override { return width * height; }
+};
+
+struct Triangle final : Shape {
+  long base;
+  long height;
+  Triangle(long base, long height) : base{base}, height{height} {}
+  auto area() const -> long override { return base * height / 2; }
+};
+
+auto type_restitution() -> void {
+  TRACE_FUNCTION();
+  PolyCollection<Shape> shapes{};
+  shapes.emplace<Square>(2);
+  shapes.emplace<Rectangle>(2, 3);
+  shapes.emplace<Triangle>(4, 3);
+  shapes.emplace<Square>(1);
+
+  // Virtual calls
+  long total{0};
+  shapes.for_each([&](Shape const &shape) { total += shape.area(); });
+  assert(total == 4 + 6 + 6 + 1);
+
+  // `shape` is a Square & or a Rectangle &: final classes, direct calls.
+  // The Triangle segment is not restituted and is visited as Shape &
+  long restituted{0};
+  shapes.for_each<Square, Rectangle>(
+      [&](auto const &shape) { restituted += shape.area(); });
+  assert(restituted == total);
+}
+
+// ____________________________________________________________________________
+// Benchmarks
+// The same shapes, in random type order, stored as a vector of pointers and
+// as a collection. The pointers are shuffled after the allocation, as in a
+// long-lived container, so that the iteration does not follow the heap
+
+auto random_shape(std::mt19937 &generator) -> int {
+  return std::uniform_int_distribution{0, 2}(generator);
+}
+
+auto bench_pointer_vector(runtime::State &state) -> void {
+  std::mt19937 generator{42};
+  std::vector<std::unique_ptr<Shape>> shapes{};
+  shapes.reserve(state.arg());
+  for (long i{0}; i < state.arg(); ++i) {
+    switch (random_shape(generator)) {
+    case 0:
+      shapes.push_back(std::make_unique<Square>(i));
+      break;
+    case 1:
+      shapes.push_back(std::make_unique<Rectangle>(i, 2));
+      break;
+    default:
+      shapes.push_back(std::make_unique<Triangle>(i, 2));
+    }
+  }
+  std::ranges::shuffle(shapes, generator);
+  state.set_throughput("Melem", state.arg() / 1e6);
+  for (auto _ : state) {
+    long total{0};
+    for (auto const &shape : shapes) {
+      total += shape->area();
+    }
+    runtime::do_not_optimize(total);
+  }
+}
+
+auto make_collection(long size) -> PolyCollection<Shape> {
+  std::mt19937 generator{42};
+  PolyCollection<Shape> shapes{};
+  for (long i{0}; i < size; ++i) {
+    switch (random_shape(generator)) {
+    case 0:
+      shapes.emplace<Square>(i);
+      break;
+    case 1:
+      shapes.emplace<Rectangle>(i, 2);
+      break;
+    default:
+      shapes.emplace<Triangle>(i, 2);
+    }
+  }
+  return shapes;
+}
+
+auto bench_virtual_segments(runtime::State &state) -> void {
+  auto shapes{make_collection(state.arg())};
+  state.set_throughput("Melem", state.arg() / 1e6);
+  for (auto _ : state) {
+    long total{0};
+    shapes.for_each([&](Shape const &shape) { total += shape.area(); });
+    runtime::do_not_optimize(total);
+  }
+}
+
+auto bench_restituted_segments(runtime::State &state) -> void {
+  auto shapes{make_collection(state.arg())};
+  state.set_throughput("Melem", state.arg() / 1e6);
+  for (auto _ : state) {
+    long total{0};
+    shapes.for_each<Square, Rectangle, Triangle>(
+        [&](auto const &shape) { total += shape.area(); });
+    runtime::do_not_optimize(total);
+  }
+}
+
+// ____________________________________________________________________________
+
+auto run() -> void {
+  segments();
+  type_restitution();
+}
+
+runtime::ModuleRegistrar const registrar{"poly_collection", run};
+
+runtime::BenchmarkRegistrar const benchmarks[]{
+    {"poly_collection::pointer_vector", bench_pointer_vector,
+     {1'000, 10'000, 100'000, 1'000'000, 10'000'000}},
+    {"poly_collection::virtual_segments", bench_virtual_segments,
+     {1'000, 10'000, 100'000, 1'000'000, 10'000'000}},
+    {"poly_collection::restituted_segments", bench_restituted_segments,
+     {1'000, 10'000, 100'000, 1'000'000, 10'000'000}},
+};
+
+} // namespace poly_collection
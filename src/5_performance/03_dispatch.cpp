@@ -0,0 +1,347 @@
+#include "../header.h"
+#include <array>
+#include <cstdint>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace dispatch {
+
+/*
+The same operation, the area of a shape, dispatched on the dynamic type of
+each element of a mixed sequence in five ways:
+- virtual:   an indirect call through the vtable
+- final:     a switch on a type tag, then a direct call to the member of a
+             final class, which the compiler inlines
+- CRTP:      static interface without vtable; a heterogeneous sequence still
+             needs a runtime tag to pick the type
+- variant:   std::visit on a std::variant of value types
+- jump table: a hand-rolled visit indexing an array of function pointers
+*/
+
+enum class Kind : std::uint8_t { square, rectangle, circle };
+
+// ____________________________________________________________________________
+// Virtual and final
+
+struct Shape {
+  explicit Shape(Kind kind) : kind{kind} {}
+  virtual ~Shape() = default;
+  virtual auto area() const -> long = 0;
+
+  // Only read by the devirtualized dispatch
+  Kind const kind;
+};
+
+struct Square final : Shape {
+  explicit Square(long side) : Shape{Kind::square}, side{side} {}
+  auto area() const -> long override { return side * side; }
+  long side;
+};
+
+struct Rectangle final : Shape {
+  Rectangle(long width, long height)
+      : Shape{Kind::rectangle}, width{width}, height{height} {}
+  auto area() const -> long override { return width * height; }
+  long width;
+  long height;
+};
+
+struct Circle final : Shape {
+  explicit Circle(long radius) : Shape{Kind::circle}, radius{radius} {}
+  auto area() const -> long override { return 355 * radius * radius / 113; }
+  long radius;
+};
+
+auto virtual_area(Shape const &shape) -> long { return shape.area(); }
+
+// The classes are final: the qualified type fixes the function to call
+auto final_area(Shape const &shape) -> long {
+  switch (shape.kind) {
+  case Kind::square:
+    return static_cast<Square const &>(shape).area();
+  case Kind::rectangle:
+    return static_cast<Rectangle const &>(shape).area();
+  case Kind::circle:
+    return static_cast<Circle const &>(shape).area();
+  }
+  return 0;
+}
+
+// ____________________________________________________________________________
+// CRTP
+
+template <typename Derived> struct ShapeCRTP {
+  auto area() const -> long {
+    return static_cast<Derived const &>(*this).area_impl();
+  }
+};
+
+struct SquareCRTP : ShapeCRTP<SquareCRTP> {
+  long side;
+  auto area_impl() const -> long { return side * side; }
+};
+
+struct RectangleCRTP : ShapeCRTP<RectangleCRTP> {
+  long width;
+  long height;
+  auto area_impl() const -> long { return width * height; }
+};
+
+struct CircleCRTP : ShapeCRTP<CircleCRTP> {
+  long radius;
+  auto area_impl() const -> long { return 355 * radius * radius / 113; }
+};
+
+// Compile-time polymorphism: one instantiation per type
+template <typename S> auto crtp_area(ShapeCRTP<S> const &shape) -> long {
+  return shape.area();
+}
+
+// Element of a heterogeneous sequence: a type tag and an index in the array
+// of that type
+struct Handle {
+  Kind kind;
+  std::uint32_t index;
+};
+
+struct CRTPShapes {
+  std::vector<SquareCRTP> squares{};
+  std::vector<RectangleCRTP> rectangles{};
+  std::vector<CircleCRTP> circles{};
+
+  auto area(Handle handle) const -> long {
+    switch (handle.kind) {
+    case Kind::square:
+      return crtp_area(squares[handle.index]);
+    case Kind::rectangle:
+      return crtp_area(rectangles[handle.index]);
+    case Kind::circle:
+      return crtp_area(circles[handle.index]);
+    }
+    return 0;
+  }
+};
+
+// ____________________________________________________________________________
+// Variant and jump table
+
+using ShapeVariant = std::variant<SquareCRTP, RectangleCRTP, CircleCRTP>;
+
+auto variant_area(ShapeVariant const &shape) -> long {
+  return std::visit([](auto const &s) { return s.area(); }, shape);
+}
+
+template <typename F, typename Variant>
+using VisitResult =
+    std::invoke_result_t<F &, std::variant_alternative_t<0, Variant> const &>;
+
+template <std::size_t I, typename F, typename Variant>
+auto call_alternative(F &function, Variant const &variant)
+    -> VisitResult<F, Variant> {
+  return function(*std::get_if<I>(&variant));
+}
+
+// One table of function pointers per (function, variant) pair, indexed by the
+// active alternative
+template <typename F, typename... Ts>
+auto table_visit(F function, std::variant<Ts...> const &variant) {
+  return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+    constexpr std::array table{
+        &call_alternative<Is, F, std::variant<Ts...>>...};
+    return table[variant.index()](function, variant);
+  }(std::index_sequence_for<Ts...>{});
+}
+
+auto table_area(ShapeVariant const &shape) -> long {
+  return table_visit([](auto const &s) { return s.area(); }, shape);
+}
+
+// ____________________________________________________________________________
+// Workload
+// A sequence of shapes, in every representation. Objects of the same type are
+// stored contiguously, so that only the dispatch differs
+
+enum class Order {
+  predictable, // square, rectangle, circle, square, ...
+  random,
+};
+
+struct Workload {
+  std::vector<Square> squares{};
+  std::vector<Rectangle> rectangles{};
+  std::vector<Circle> circles{};
+  std::vector<Shape const *> shapes{};
+
+  CRTPShapes crtp{};
+  std::vector<Handle> handles{};
+
+  std::vector<ShapeVariant> variants{};
+
+  Workload(std::size_t size, Order order) {
+    std::mt19937 generator{42};
+    std::uniform_int_distribution<int> random_kind{0, 2};
+    std::vector<Kind> kinds(size);
+    for (std::size_t i{0}; i < size; ++i) {
+      kinds[i] = static_cast<Kind>(
+          order == Order::predictable ? static_cast<int>(i % 3)
+                                      : random_kind(generator));
+    }
+
+    // No reallocation: the pointers stay valid
+    squares.reserve(size);
+    rectangles.reserve(size);
+    circles.reserve(size);
+    for (std::size_t i{0}; i < size; ++i) {
+      auto const value{static_cast<long>(i % 100)};
+      switch (kinds[i]) {
+      case Kind::square:
+        shapes.push_back(&squares.emplace_back(value));
+        handles.push_back({Kind::square, index(crtp.squares)});
+        crtp.squares.push_back({{}, value});
+        variants.emplace_back(SquareCRTP{{}, value});
+        break;
+      case Kind::rectangle:
+        shapes.push_back(&rectangles.emplace_back(value, 2));
+        handles.push_back({Kind::rectangle, index(crtp.rectangles)});
+        crtp.rectangles.push_back({{}, value, 2});
+        variants.emplace_back(RectangleCRTP{{}, value, 2});
+        break;
+      case Kind::circle:
+        shapes.push_back(&circles.emplace_back(value));
+        handles.push_back({Kind::circle, index(crtp.circles)});
+        crtp.circles.push_back({{}, value});
+        variants.emplace_back(CircleCRTP{{}, value});
+        break;
+      }
+    }
+  }
+
+private:
+  template <typename T>
+  static auto index(std::vector<T> const &array) -> std::uint32_t {
+    return static_cast<std::uint32_t>(array.size());
+  }
+};
+
+auto total_areas() -> void {
+  TRACE_FUNCTION();
+  for (auto order : {Order::predictable, Order::random}) {
+    Workload const workload{300, order};
+
+    long virtual_total{0};
+    long final_total{0};
+    for (auto shape : workload.shapes) {
+      virtual_total += virtual_area(*shape);
+      final_total += final_area(*shape);
+    }
+
+    long crtp_total{0};
+    for (auto handle : workload.handles) {
+      crtp_total += workload.crtp.area(handle);
+    }
+
+    long variant_total{0};
+    long table_total{0};
+    for (auto const &shape : workload.variants) {
+      variant_total += variant_area(shape);
+      table_total += table_area(shape);
+    }
+
+    assert(final_total == virtual_total);
+    assert(crtp_total == virtual_total);
+    assert(variant_total == virtual_total);
+    assert(table_total == virtual_total);
+  }
+}
+
+// ____________________________________________________________________________
+// Benchmarks
+// 10'000 shapes fit in the L1 and L2 caches: the loops are bound by the
+// dispatch. With random types every mechanism pays for branch mispredictions,
+// indirect (virtual, jump table) or conditional (switch)
+
+inline constexpr std::size_t workload_size{10'000};
+
+template <Order order> auto bench_virtual(runtime::State &state) -> void {
+  Workload const workload{workload_size, order};
+  state.set_throughput("Mcall", workload_size / 1e6);
+  for (auto _ : state) {
+    long total{0};
+    for (auto shape : workload.shapes) {
+      total += virtual_area(*shape);
+    }
+    runtime::do_not_optimize(total);
+  }
+}
+
+template <Order order> auto bench_final(runtime::State &state) -> void {
+  Workload const workload{workload_size, order};
+  state.set_throughput("Mcall", workload_size / 1e6);
+  for (auto _ : state) {
+    long total{0};
+    for (auto shape : workload.shapes) {
+      total += final_area(*shape);
+    }
+    runtime::do_not_optimize(total);
+  }
+}
+
+template <Order order> auto bench_crtp(runtime::State &state) -> void {
+  Workload const workload{workload_size, order};
+  state.set_throughput("Mcall", workload_size / 1e6);
+  for (auto _ : state) {
+    long total{0};
+    for (auto handle : workload.handles) {
+      total += workload.crtp.area(handle);
+    }
+    runtime::do_not_optimize(total);
+  }
+}
+
+template <Order order> auto bench_variant(runtime::State &state) -> void {
+  Workload const workload{workload_size, order};
+  state.set_throughput("Mcall", workload_size / 1e6);
+  for (auto _ : state) {
+    long total{0};
+    for (auto const &shape : workload.variants) {
+      total += variant_area(shape);
+    }
+    runtime::do_not_optimize(total);
+  }
+}
+
+template <Order order> auto bench_jump_table(runtime::State &state) -> void {
+  Workload const workload{workload_size, order};
+  state.set_throughput("Mcall", workload_size / 1e6);
+  for (auto _ : state) {
+    long total{0};
+    for (auto const &shape : workload.variants) {
+      total += table_area(shape);
+    }
+    runtime::do_not_optimize(total);
+  }
+}
+
+// ____________________________________________________________________________
+
+auto run() -> void { total_areas(); }
+
+runtime::ModuleRegistrar const registrar{"dispatch", run};
+
+runtime::BenchmarkRegistrar const benchmarks[]{
+    {"dispatch::virtual_predictable", bench_virtual<Order::predictable>},
+    {"dispatch::final_predictable", bench_final<Order::predictable>},
+    {"dispatch::crtp_predictable", bench_crtp<Order::predictable>},
+    {"dispatch::variant_predictable", bench_variant<Order::predictable>},
+    {"dispatch::jump_table_predictable", bench_jump_table<Order::predictable>},
+    {"dispatch::virtual_random", bench_virtual<Order::random>},
+    {"dispatch::final_random", bench_final<Order::random>},
+    {"dispatch::crtp_random", bench_crtp<Order::random>},
+    {"dispatch::variant_random", bench_variant<Order::random>},
+    {"dispatch::jump_table_random", bench_jump_table<Order::random>},
+};
+
+} // namespace dispatch
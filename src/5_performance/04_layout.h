@@ -0,0 +1,148 @@
+#ifndef layout_h
+#define layout_h
+
+#include <algorithm>
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
+
+namespace layout {
+
+// ____________________________________________________________________________
+// Layout descriptions
+/*
+The standard gives sizeof, alignof and the type traits, but no way to list
+the data members and the bases of a class. A Description supplies them:
+- members:       types of the non-static data members, in any order
+- bases:         direct non-virtual bases
+- virtual_bases: every virtual base, direct or indirect, once
+
+From these, the layout is split into data, vptrs and padding. The vptrs follow
+the Itanium C++ ABI (GCC, Clang): a dynamic class (polymorphic or with virtual
+bases) shares the vptr of its first dynamic non-virtual base and otherwise
+adds its own; every virtual base keeps its vptrs. A description that does not
+fit in the size of the class fails to compile
+*/
+
+template <typename... Ts> struct Types {};
+
+template <typename T> struct Description;
+
+template <typename Members, typename Bases = Types<>,
+          typename VirtualBases = Types<>>
+struct Describe {
+  using members = Members;
+  using bases = Bases;
+  using virtual_bases = VirtualBases;
+};
+
+struct LayoutInfo {
+  std::string_view name;
+  std::size_t size;
+  std::size_t alignment;
+  std::size_t data;    // data members, inherited ones included
+  std::size_t vptrs;   // pointers to virtual tables
+  std::size_t padding; // everything else
+  bool polymorphic;
+  bool standard_layout;
+  bool trivially_copyable;
+};
+
+template <typename T> constexpr auto nonvirtual_data() -> std::size_t;
+template <typename T> constexpr auto nonvirtual_vptrs() -> std::size_t;
+
+template <typename... Ts>
+constexpr auto members_size(Types<Ts...>, bool is_union) -> std::size_t {
+  return is_union ? std::max({std::size_t{0}, sizeof(Ts)...})
+                  : (std::size_t{0} + ... + sizeof(Ts));
+}
+
+template <typename... Ts> constexpr auto data_of(Types<Ts...>) -> std::size_t {
+  return (std::size_t{0} + ... + nonvirtual_data<Ts>());
+}
+
+template <typename... Ts> constexpr auto vptrs_of(Types<Ts...>) -> std::size_t {
+  return (std::size_t{0} + ... + nonvirtual_vptrs<Ts>());
+}
+
+template <typename... Ts> constexpr auto count(Types<Ts...>) -> std::size_t {
+  return sizeof...(Ts);
+}
+
+// Data of T without its virtual bases
+template <typename T> constexpr auto nonvirtual_data() -> std::size_t {
+  using D = Description<T>;
+  return members_size(typename D::members{}, std::is_union_v<T>) +
+         data_of(typename D::bases{});
+}
+
+// Vptrs of T without those of its virtual bases
+template <typename T> constexpr auto nonvirtual_vptrs() -> std::size_t {
+  using D = Description<T>;
+  auto const inherited{vptrs_of(typename D::bases{})};
+  auto const dynamic{std::is_polymorphic_v<T> ||
+                     count(typename D::virtual_bases{}) > 0};
+  return inherited + (dynamic && inherited == 0 ? 1 : 0);
+}
+
+template <typename T>
+constexpr auto layout_of(std::string_view name) -> LayoutInfo {
+  using D = Description<T>;
+  constexpr auto data{nonvirtual_data<T>() +
+                      data_of(typename D::virtual_bases{})};
+  constexpr auto vptrs{nonvirtual_vptrs<T>() +
+                       vptrs_of(typename D::virtual_bases{})};
+  constexpr auto used{std::is_empty_v<T> ? 0 : data + vptrs * sizeof(void *)};
+  static_assert(used <= sizeof(T), "description larger than the class");
+  return {name,
+          sizeof(T),
+          alignof(T),
+          data,
+          vptrs,
+          sizeof(T) - used,
+          std::is_polymorphic_v<T>,
+          std::is_standard_layout_v<T>,
+          std::is_trivially_copyable_v<T>};
+}
+
+// ____________________________________________________________________________
+// Diamonds
+// The hierarchy of hierarchies::virtual_inheritance(), with an int member
+
+struct Base {
+  int value{};
+};
+
+// Two Base subobjects at fixed offsets
+struct Left : Base {};
+struct Right : Base {};
+struct Diamond : Left, Right {};
+
+// One shared Base subobject, located through the vtable
+struct VirtualLeft : virtual Base {};
+struct VirtualRight : virtual Base {};
+struct VirtualDiamond : VirtualLeft, VirtualRight {};
+
+// No class can derive from it: its Base subobject is at a known offset when
+// accessed through the most derived type
+struct FinalDiamond final : VirtualLeft, VirtualRight {};
+
+template <> struct Description<Base> : Describe<Types<int>> {};
+template <> struct Description<Left> : Describe<Types<>, Types<Base>> {};
+template <> struct Description<Right> : Describe<Types<>, Types<Base>> {};
+template <>
+struct Description<Diamond> : Describe<Types<>, Types<Left, Right>> {};
+template <>
+struct Description<VirtualLeft> : Describe<Types<>, Types<>, Types<Base>> {};
+template <>
+struct Description<VirtualRight> : Describe<Types<>, Types<>, Types<Base>> {};
+template <>
+struct Description<VirtualDiamond>
+    : Describe<Types<>, Types<VirtualLeft, VirtualRight>, Types<Base>> {};
+template <>
+struct Description<FinalDiamond>
+    : Describe<Types<>, Types<VirtualLeft, VirtualRight>, Types<Base>> {};
+
+} // namespace layout
+
+#endif
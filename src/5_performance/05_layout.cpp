@@ -0,0 +1,97 @@
+#include "../header.h"
+#include "04_layout.h"
+#include <vector>
+
+namespace layout {
+
+// ____________________________________________________________________________
+// Subobjects
+
+auto subobjects() -> void {
+  TRACE_FUNCTION();
+  {
+    // Ordinary inheritance: one Base per path
+    Diamond diamond{};
+    static_cast<Left &>(diamond).value = 1;
+    static_cast<Right &>(diamond).value = 2;
+    assert(static_cast<Left &>(diamond).value == 1);
+    static_assert(layout_of<Diamond>("").data == 2 * sizeof(int));
+    static_assert(layout_of<Diamond>("").vptrs == 0);
+  }
+  {
+    // Virtual inheritance: one shared Base, at an offset read from the vtable
+    VirtualDiamond diamond{};
+    static_cast<VirtualLeft &>(diamond).value = 1;
+    static_cast<VirtualRight &>(diamond).value = 2;
+    assert(static_cast<VirtualLeft &>(diamond).value == 2);
+    static_assert(layout_of<VirtualDiamond>("").data == sizeof(int));
+    static_assert(layout_of<VirtualDiamond>("").vptrs == 2);
+  }
+}
+
+// ____________________________________________________________________________
+// Benchmarks
+// Reads Base::value through a pointer to an intermediate class. With an
+// ordinary base the member is at a constant offset; with a virtual base the
+// offset is loaded from the vtable first (this-adjustment), unless the
+// complete type is known to be final
+
+inline constexpr std::size_t objects{1024};
+
+template <typename Object, typename Pointer>
+auto pointers_to(std::vector<Object> &array) -> std::vector<Pointer *> {
+  std::vector<Pointer *> pointers{};
+  for (auto &object : array) {
+    pointers.push_back(&object);
+  }
+  return pointers;
+}
+
+template <typename Pointer> auto sum(std::vector<Pointer *> const &pointers) {
+  int total{0};
+  for (auto pointer : pointers) {
+    total += pointer->value;
+  }
+  return total;
+}
+
+auto bench_non_virtual_base(runtime::State &state) -> void {
+  std::vector<Diamond> array(objects);
+  auto const pointers{pointers_to<Diamond, Left>(array)};
+  state.set_throughput("Maccess", objects / 1e6);
+  for (auto _ : state) {
+    runtime::do_not_optimize(sum(pointers));
+  }
+}
+
+auto bench_virtual_base(runtime::State &state) -> void {
+  std::vector<VirtualDiamond> array(objects);
+  auto const pointers{pointers_to<VirtualDiamond, VirtualLeft>(array)};
+  state.set_throughput("Maccess", objects / 1e6);
+  for (auto _ : state) {
+    runtime::do_not_optimize(sum(pointers));
+  }
+}
+
+auto bench_final_virtual_base(runtime::State &state) -> void {
+  std::vector<FinalDiamond> array(objects);
+  auto const pointers{pointers_to<FinalDiamond, FinalDiamond>(array)};
+  state.set_throughput("Maccess", objects / 1e6);
+  for (auto _ : state) {
+    runtime::do_not_optimize(sum(pointers));
+  }
+}
+
+// ____________________________________________________________________________
+
+auto run() -> void { subobjects(); }
+
+runtime::ModuleRegistrar const registrar{"layout", run};
+
+runtime::BenchmarkRegistrar const benchmarks[]{
+    {"layout::non_virtual_base", bench_non_virtual_base},
+    {"layout::virtual_base", bench_virtual_base},
+    {"layout::final_virtual_base", bench_final_virtual_base},
+};
+
+} // namespace layout
@@ -0,0 +1,174 @@
+#ifndef poly_value_h
+#define poly_value_h
+
+#include <concepts>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace poly_value {
+
+// ____________________________________________________________________________
+// Polymorphic value
+/*
+PolyValue<Interface> holds an object of any class derived from Interface by
+value: copying a PolyValue copies the derived object (no slicing), moving it
+moves the derived object, destroying it destroys the derived object.
+
+Objects up to `Capacity` bytes, suitably aligned and with a non-throwing move
+constructor, are stored in a buffer inside the PolyValue; larger ones are
+allocated on the heap and the buffer holds a pointer to them. Calls go
+through the Interface pointer, kept next to the buffer, so that access does
+not depend on where the object lives.
+
+A moved-from PolyValue is empty: it can only be assigned or destroyed
+*/
+
+template <typename Interface, std::size_t Capacity = 3 * sizeof(void *),
+          std::size_t Alignment = alignof(std::max_align_t)>
+class PolyValue {
+  static_assert(Capacity >= sizeof(void *), "the buffer must fit a pointer");
+  static_assert(std::has_virtual_destructor_v<Interface>);
+
+public:
+  template <typename T>
+  static constexpr bool fits_inline{sizeof(T) <= Capacity &&
+                                    alignof(T) <= Alignment &&
+                                    std::is_nothrow_move_constructible_v<T>};
+
+  // Constructs a T from `args`
+  template <std::derived_from<Interface> T, typename... Args>
+    requires std::copy_constructible<T>
+  explicit PolyValue(std::in_place_type_t<T>, Args &&...args) {
+    if constexpr (fits_inline<T>) {
+      _object = ::new (_buffer) T(std::forward<Args>(args)...);
+    } else {
+      _object = *::new (_buffer) T *(new T(std::forward<Args>(args)...));
+    }
+    _operations = &operations<T>;
+  }
+
+  // Copies or moves a derived object
+  template <typename T>
+    requires std::derived_from<std::remove_cvref_t<T>, Interface> &&
+             (!std::same_as<std::remove_cvref_t<T>, PolyValue>)
+  PolyValue(T &&object)
+      : PolyValue{std::in_place_type<std::remove_cvref_t<T>>,
+                  std::forward<T>(object)} {}
+
+  PolyValue(PolyValue const &other) {
+    if (other._operations) {
+      other._operations->copy(other, *this);
+    }
+  }
+
+  PolyValue(PolyValue &&other) noexcept {
+    if (other._operations) {
+      other._operations->move(other, *this);
+    }
+  }
+
+  auto operator=(PolyValue const &other) -> PolyValue & {
+    if (this != &other) {
+      // Strong guarantee: the copy may throw, the move does not
+      *this = PolyValue{other};
+    }
+    return *this;
+  }
+
+  auto operator=(PolyValue &&other) noexcept -> PolyValue & {
+    if (this != &other) {
+      reset();
+      if (other._operations) {
+        other._operations->move(other, *this);
+      }
+    }
+    return *this;
+  }
+
+  ~PolyValue() { reset(); }
+
+  auto operator->() -> Interface * { return _object; }
+  auto operator->() const -> Interface const * { return _object; }
+  auto operator*() -> Interface & { return *_object; }
+  auto operator*() const -> Interface const & { return *_object; }
+
+  auto empty() const -> bool { return _object == nullptr; }
+
+  // Whether the object is stored in the buffer
+  auto is_inline() const -> bool {
+    return _operations && _operations->is_inline;
+  }
+
+private:
+  // Type-erased special members of the stored type
+  struct Operations {
+    auto (*copy)(PolyValue const &from, PolyValue &to) -> void;
+    auto (*move)(PolyValue &from, PolyValue &to) noexcept -> void;
+    auto (*destroy)(PolyValue &value) noexcept -> void;
+    bool is_inline;
+  };
+
+  Interface *_object{nullptr};
+  Operations const *_operations{nullptr};
+  alignas(Alignment) std::byte _buffer[Capacity];
+
+  auto reset() noexcept -> void {
+    if (_operations) {
+      _operations->destroy(*this);
+      _object = nullptr;
+      _operations = nullptr;
+    }
+  }
+
+  template <typename T> static auto stored(PolyValue const &value) -> T * {
+    if constexpr (fits_inline<T>) {
+      return std::launder(reinterpret_cast<T *>(
+          const_cast<std::byte *>(value._buffer)));
+    } else {
+      return *std::launder(reinterpret_cast<T *const *>(value._buffer));
+    }
+  }
+
+  template <typename T>
+  static auto copy(PolyValue const &from, PolyValue &to) -> void {
+    if constexpr (fits_inline<T>) {
+      to._object = ::new (to._buffer) T(*stored<T>(from));
+    } else {
+      to._object = *::new (to._buffer) T *(new T(*stored<T>(from)));
+    }
+    to._operations = from._operations;
+  }
+
+  template <typename T>
+  static auto move(PolyValue &from, PolyValue &to) noexcept -> void {
+    if constexpr (fits_inline<T>) {
+      auto const object{stored<T>(from)};
+      to._object = ::new (to._buffer) T(std::move(*object));
+      object->~T();
+    } else {
+      // The heap object stays where it is
+      to._object = *::new (to._buffer) T *(stored<T>(from));
+    }
+    to._operations = from._operations;
+    from._object = nullptr;
+    from._operations = nullptr;
+  }
+
+  template <typename T> static auto destroy(PolyValue &value) noexcept -> void {
+    if constexpr (fits_inline<T>) {
+      stored<T>(value)->~T();
+    } else {
+      delete stored<T>(value);
+    }
+  }
+
+  template <typename T>
+  static constexpr Operations operations{&copy<T>, &move<T>, &destroy<T>,
+                                         fits_inline<T>};
+};
+
+} // namespace poly_value
+
+#endif
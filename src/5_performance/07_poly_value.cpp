@@ -0,0 +1,198 @@
+#include "../header.h"
+#include "06_poly_value.h"
+#include <array>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+namespace poly_value {
+
+struct Shape {
+  virtual ~Shape() = default;
+  virtual auto area() const -> long = 0;
+  virtual auto scale(long factor) -> void = 0;
+  // Needed to copy through a unique_ptr only
+  virtual auto clone() const -> std::unique_ptr<Shape> = 0;
+};
+
+struct Square final : Shape {
+  long side;
+  explicit Square(long side) : side{side} {}
+  auto area() const -> long override { return side * side; }
+  auto scale(long factor) -> void override { side *= factor; }
+  auto clone() const -> std::unique_ptr<Shape> override {
+    return std::make_unique<Square>(*this);
+  }
+};
+
+struct Rectangle final : Shape {
+  long width;
+  long height;
+  Rectangle(long width, long height) : width{width}, height{height} {}
+  auto area() const -> long override { return width * height; }
+  auto scale(long factor) -> void override {
+    width *= factor;
+    height *= factor;
+  }
+  auto clone() const -> std::unique_ptr<Shape> override {
+    return std::make_unique<Rectangle>(*this);
+  }
+};
+
+// Larger than the buffer: stored on the heap
+struct Polygon final : Shape {
+  std::array<long, 8> sides;
+  explicit Polygon(long side) { sides.fill(side); }
+  auto area() const -> long override {
+    return std::accumulate(sides.begin(), sides.end(), 0l);
+  }
+  auto scale(long factor) -> void override {
+    for (auto &side : sides) {
+      side *= factor;
+    }
+  }
+  auto clone() const -> std::unique_ptr<Shape> override {
+    return std::make_unique<Polygon>(*this);
+  }
+};
+
+// ____________________________________________________________________________
+// Value semantics
+
+auto value_semantics() -> void {
+  TRACE_FUNCTION();
+  PolyValue<Shape> square{Square{2}};
+  PolyValue<Shape> polygon{Polygon{1}};
+  assert(square.is_inline());
+  assert(!polygon.is_inline());
+
+  {
+    // Copies are deep and keep the dynamic type: no slicing
+    auto copy{square};
+    copy->scale(10);
+    assert(copy->area() == 400);
+    assert(square->area() == 4);
+    assert(dynamic_cast<Square const *>(&*copy) != nullptr);
+  }
+  {
+    // Moves leave the source empty
+    auto moved{std::move(polygon)};
+    assert(polygon.empty());
+    assert(moved->area() == 8);
+    polygon = moved;
+    assert(polygon->area() == 8);
+  }
+  {
+    // Containers of values
+    std::vector<PolyValue<Shape>> shapes{};
+    shapes.emplace_back(Square{1});
+    shapes.emplace_back(Rectangle{2, 3});
+    shapes.emplace_back(Polygon{1});
+    auto const copies{shapes};
+    long total{0};
+    for (auto const &shape : copies) {
+      total += shape->area();
+    }
+    assert(total == 1 + 6 + 8);
+  }
+}
+
+// ____________________________________________________________________________
+// Benchmarks
+// PolyValue against unique_ptr<Shape>: creation, copy (a virtual clone for
+// the pointer) and calls over 1'000 shapes
+
+auto bench_create_unique_ptr(runtime::State &state) -> void {
+  for (auto _ : state) {
+    std::unique_ptr<Shape> shape{std::make_unique<Rectangle>(2, 3)};
+    runtime::do_not_optimize(shape);
+  }
+}
+
+auto bench_create_poly_value(runtime::State &state) -> void {
+  for (auto _ : state) {
+    PolyValue<Shape> shape{std::in_place_type<Rectangle>, 2, 3};
+    runtime::do_not_optimize(shape);
+  }
+}
+
+auto bench_create_poly_value_heap(runtime::State &state) -> void {
+  for (auto _ : state) {
+    PolyValue<Shape> shape{std::in_place_type<Polygon>, 2};
+    runtime::do_not_optimize(shape);
+  }
+}
+
+auto bench_copy_unique_ptr(runtime::State &state) -> void {
+  std::unique_ptr<Shape> const shape{std::make_unique<Rectangle>(2, 3)};
+  for (auto _ : state) {
+    auto copy{shape->clone()};
+    runtime::do_not_optimize(copy);
+  }
+}
+
+auto bench_copy_poly_value(runtime::State &state) -> void {
+  PolyValue<Shape> const shape{Rectangle{2, 3}};
+  for (auto _ : state) {
+    auto copy{shape};
+    runtime::do_not_optimize(copy);
+  }
+}
+
+inline constexpr long shapes_count{1'000};
+
+auto bench_call_unique_ptr(runtime::State &state) -> void {
+  std::vector<std::unique_ptr<Shape>> shapes{};
+  for (long i{0}; i < shapes_count; ++i) {
+    if (i % 2 == 0) {
+      shapes.push_back(std::make_unique<Square>(i));
+    } else {
+      shapes.push_back(std::make_unique<Rectangle>(i, 2));
+    }
+  }
+  state.set_throughput("Mcall", shapes_count / 1e6);
+  for (auto _ : state) {
+    long total{0};
+    for (auto const &shape : shapes) {
+      total += shape->area();
+    }
+    runtime::do_not_optimize(total);
+  }
+}
+
+auto bench_call_poly_value(runtime::State &state) -> void {
+  std::vector<PolyValue<Shape>> shapes{};
+  for (long i{0}; i < shapes_count; ++i) {
+    if (i % 2 == 0) {
+      shapes.emplace_back(Square{i});
+    } else {
+      shapes.emplace_back(Rectangle{i, 2});
+    }
+  }
+  state.set_throughput("Mcall", shapes_count / 1e6);
+  for (auto _ : state) {
+    long total{0};
+    for (auto const &shape : shapes) {
+      total += shape->area();
+    }
+    runtime::do_not_optimize(total);
+  }
+}
+
+// ____________________________________________________________________________
+
+auto run() -> void { value_semantics(); }
+
+runtime::ModuleRegistrar const registrar{"poly_value", run};
+
+runtime::BenchmarkRegistrar const benchmarks[]{
+    {"poly_value::create_unique_ptr", bench_create_unique_ptr},
+    {"poly_value::create_poly_value", bench_create_poly_value},
+    {"poly_value::create_poly_value_heap", bench_create_poly_value_heap},
+    {"poly_value::copy_unique_ptr", bench_copy_unique_ptr},
+    {"poly_value::copy_poly_value", bench_copy_poly_value},
+    {"poly_value::call_unique_ptr", bench_call_unique_ptr},
+    {"poly_value::call_poly_value", bench_call_poly_value},
+};
+
+} // namespace poly_value
@@ -0,0 +1,201 @@
+#ifndef resource_handle_h
+#define resource_handle_h
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace resource_handle {
+
+// ____________________________________________________________________________
+// Storage policies
+// Where a ResourceHandle keeps its object. A storage starts empty and
+// provides emplace(args...), get() (nullptr when empty), a non-throwing swap,
+// and releases the object when destroyed
+
+// One heap allocation per object, as classes::MoveAndCopyClass
+template <typename T> class HeapStorage {
+public:
+  HeapStorage() = default;
+  HeapStorage(HeapStorage const &) = delete;
+  HeapStorage &operator=(HeapStorage const &) = delete;
+  ~HeapStorage() { delete _object; }
+
+  template <typename... Args> auto emplace(Args &&...args) -> void {
+    _object = new T(std::forward<Args>(args)...);
+  }
+
+  auto get() -> T * { return _object; }
+  auto get() const -> T const * { return _object; }
+
+  auto swap(HeapStorage &other) noexcept -> void {
+    std::swap(_object, other._object);
+  }
+
+private:
+  T *_object{nullptr};
+};
+
+// Fixed-size blocks carved from 4 KiB slabs, recycled through a free list.
+// One pool per thread and type: no synchronization. An object must be
+// destroyed by the thread that created it, before the thread exits
+template <typename T> class SlabPool {
+public:
+  static auto local() -> SlabPool & {
+    thread_local SlabPool pool{};
+    return pool;
+  }
+
+  auto allocate() -> void * {
+    if (_free) {
+      return std::exchange(_free, _free->next);
+    }
+    if (_next == _end) {
+      auto &slab{_slabs.emplace_back(
+          std::make_unique_for_overwrite<Block[]>(blocks_per_slab))};
+      _next = slab.get();
+      _end = _next + blocks_per_slab;
+    }
+    return _next++;
+  }
+
+  auto deallocate(void *pointer) noexcept -> void {
+    auto const block{static_cast<Block *>(pointer)};
+    block->next = _free;
+    _free = block;
+  }
+
+private:
+  union Block {
+    Block *next;
+    alignas(T) std::byte storage[sizeof(T)];
+  };
+
+  static constexpr std::size_t blocks_per_slab{
+      std::max<std::size_t>(4096 / sizeof(Block), 16)};
+
+  std::vector<std::unique_ptr<Block[]>> _slabs{};
+  Block *_free{nullptr};
+  Block *_next{nullptr};
+  Block *_end{nullptr};
+};
+
+template <typename T> class PoolStorage {
+public:
+  PoolStorage() = default;
+  PoolStorage(PoolStorage const &) = delete;
+  PoolStorage &operator=(PoolStorage const &) = delete;
+  ~PoolStorage() {
+    if (_object) {
+      _object->~T();
+      SlabPool<T>::local().deallocate(_object);
+    }
+  }
+
+  template <typename... Args> auto emplace(Args &&...args) -> void {
+    auto &pool{SlabPool<T>::local()};
+    auto const block{pool.allocate()};
+    try {
+      _object = ::new (block) T(std::forward<Args>(args)...);
+    } catch (...) {
+      pool.deallocate(block);
+      throw;
+    }
+  }
+
+  auto get() -> T * { return _object; }
+  auto get() const -> T const * { return _object; }
+
+  auto swap(PoolStorage &other) noexcept -> void {
+    std::swap(_object, other._object);
+  }
+
+private:
+  T *_object{nullptr};
+};
+
+// The object lives inside the handle: no allocation, but moving the handle
+// moves the object
+template <typename T> class InlineStorage {
+public:
+  template <typename... Args> auto emplace(Args &&...args) -> void {
+    _object.emplace(std::forward<Args>(args)...);
+  }
+
+  auto get() -> T * { return _object ? &*_object : nullptr; }
+  auto get() const -> T const * { return _object ? &*_object : nullptr; }
+
+  auto swap(InlineStorage &other) noexcept -> void {
+    _object.swap(other._object);
+  }
+
+private:
+  std::optional<T> _object{};
+};
+
+// ____________________________________________________________________________
+// Resource handle
+/*
+The pattern of classes::MoveAndCopyClass and classes::MoveOnlyClass, generic
+over the resource and where it is stored:
+- copying deep-copies the object (only if T is copyable)
+- moving swaps with an empty handle, the source is left empty
+- assignment takes its argument by value: copy-and-swap
+
+NoexceptMove exists to show its cost: std::vector relocates its elements
+with std::move_if_noexcept, so on reallocation a handle whose move
+constructor may throw is copied, one deep copy per element
+*/
+
+template <typename T, template <typename> typename Storage = HeapStorage,
+          bool NoexceptMove = true>
+class ResourceHandle {
+public:
+  template <typename... Args>
+    requires std::constructible_from<T, Args...>
+  explicit ResourceHandle(Args &&...args) {
+    _storage.emplace(std::forward<Args>(args)...);
+  }
+
+  ResourceHandle(ResourceHandle const &other)
+    requires std::copy_constructible<T>
+  {
+    if (other) {
+      _storage.emplace(*other);
+    }
+  }
+
+  ResourceHandle(ResourceHandle &&other) noexcept(NoexceptMove) {
+    swap(other);
+  }
+
+  auto operator=(ResourceHandle other) noexcept(NoexceptMove)
+      -> ResourceHandle & {
+    swap(other);
+    return *this;
+  }
+
+  explicit operator bool() const { return _storage.get() != nullptr; }
+
+  // Constness propagates to the object, as if it were a member
+  auto operator*() -> T & { return *_storage.get(); }
+  auto operator*() const -> T const & { return *_storage.get(); }
+  auto operator->() -> T * { return _storage.get(); }
+  auto operator->() const -> T const * { return _storage.get(); }
+
+  auto swap(ResourceHandle &other) noexcept -> void {
+    _storage.swap(other._storage);
+  }
+
+private:
+  Storage<T> _storage{};
+};
+
+} // namespace resource_handle
+
+#endif
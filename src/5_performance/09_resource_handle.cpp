@@ -0,0 +1,167 @@
+#include "../header.h"
+#include "../1_basics/04_classes.h"
+#include "08_resource_handle.h"
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+namespace resource_handle {
+
+// ____________________________________________________________________________
+// Storage policies
+
+auto storage_policies() -> void {
+  TRACE_FUNCTION();
+  {
+    // Copies are deep, whatever the storage
+    ResourceHandle<int> heap{1};
+    auto copy{heap};
+    *copy = 10;
+    assert(*heap == 1);
+
+    ResourceHandle<int, InlineStorage> local{2};
+    auto local_copy{local};
+    *local_copy = 20;
+    assert(*local == 2);
+  }
+  {
+    // Moves leave the source empty
+    ResourceHandle<int, PoolStorage> pool{3};
+    auto moved{std::move(pool)};
+    assert(!pool);
+    assert(*moved == 3);
+    pool = moved;
+    assert(*pool == 3);
+  }
+  {
+    // Move-only resources make move-only handles
+    ResourceHandle<std::unique_ptr<int>, InlineStorage> unique{
+        std::make_unique<int>(4)};
+    static_assert(!std::is_copy_constructible_v<decltype(unique)>);
+    assert(**unique == 4);
+  }
+  {
+    // The pool recycles the last freed block first
+    int *address{nullptr};
+    {
+      ResourceHandle<int, PoolStorage> first{5};
+      address = &*first;
+    }
+    ResourceHandle<int, PoolStorage> second{6};
+    assert(&*second == address);
+  }
+}
+
+// ____________________________________________________________________________
+// noexcept moves
+
+auto noexcept_moves() -> void {
+  TRACE_FUNCTION();
+  using classes::MoveAndCopyClass, classes::MoveOnlyClass;
+  static_assert(std::is_nothrow_move_constructible_v<MoveAndCopyClass>);
+  static_assert(std::is_nothrow_move_constructible_v<MoveOnlyClass>);
+  {
+    // Reallocation moves the handles: the objects stay where they are
+    std::vector<ResourceHandle<int>> handles{};
+    handles.emplace_back(1);
+    auto const address{&*handles[0]};
+    handles.reserve(handles.capacity() + 1);
+    assert(&*handles[0] == address);
+  }
+  {
+    // A move constructor that may throw is not used: every object is copied
+    std::vector<ResourceHandle<int, HeapStorage, false>> handles{};
+    handles.emplace_back(1);
+    auto const address{&*handles[0]};
+    handles.reserve(handles.capacity() + 1);
+    assert(&*handles[0] != address);
+    assert(*handles[0] == 1);
+  }
+}
+
+// ____________________________________________________________________________
+// Benchmarks
+// Handles of an int in growing, shifting and sorted vectors, for each storage.
+// Heap and pool handles move a pointer, inline handles move the object; only
+// the heap and the pool allocate
+
+template <template <typename> typename Storage, bool NoexceptMove = true>
+using Handle = ResourceHandle<int, Storage, NoexceptMove>;
+
+template <template <typename> typename Storage, bool NoexceptMove = true>
+auto bench_push_back(runtime::State &state) -> void {
+  state.set_throughput("Melem", state.arg() / 1e6);
+  for (auto _ : state) {
+    std::vector<Handle<Storage, NoexceptMove>> handles{};
+    for (long i{0}; i < state.arg(); ++i) {
+      handles.emplace_back(static_cast<int>(i));
+    }
+    runtime::do_not_optimize(handles.data());
+  }
+}
+
+// Every insertion shifts the whole vector by one position
+template <template <typename> typename Storage>
+auto bench_insert_front(runtime::State &state) -> void {
+  state.set_throughput("Melem", state.arg() / 1e6);
+  for (auto _ : state) {
+    std::vector<Handle<Storage>> handles{};
+    for (long i{0}; i < state.arg(); ++i) {
+      handles.insert(handles.begin(), Handle<Storage>{static_cast<int>(i)});
+    }
+    runtime::do_not_optimize(handles.data());
+  }
+}
+
+template <template <typename> typename Storage>
+auto bench_sort(runtime::State &state) -> void {
+  std::mt19937 generator{42};
+  std::vector<Handle<Storage>> input{};
+  for (long i{0}; i < state.arg(); ++i) {
+    input.emplace_back(static_cast<int>(generator()));
+  }
+  state.set_throughput("Melem", state.arg() / 1e6);
+  for (auto _ : state) {
+    state.pause_timing();
+    auto handles{input};
+    state.resume_timing();
+    std::ranges::sort(handles, {},
+                      [](Handle<Storage> const &handle) { return *handle; });
+    runtime::do_not_optimize(handles.data());
+  }
+}
+
+// ____________________________________________________________________________
+
+auto run() -> void {
+  storage_policies();
+  noexcept_moves();
+}
+
+runtime::ModuleRegistrar const registrar{"resource_handle", run};
+
+runtime::BenchmarkRegistrar const benchmarks[]{
+    {"resource_handle::push_back_heap", bench_push_back<HeapStorage>,
+     {1'000, 100'000}},
+    {"resource_handle::push_back_heap_throwing_move",
+     bench_push_back<HeapStorage, false>,
+     {1'000, 100'000}},
+    {"resource_handle::push_back_pool", bench_push_back<PoolStorage>,
+     {1'000, 100'000}},
+    {"resource_handle::push_back_inline", bench_push_back<InlineStorage>,
+     {1'000, 100'000}},
+    {"resource_handle::insert_front_heap", bench_insert_front<HeapStorage>,
+     {1'000, 10'000}},
+    {"resource_handle::insert_front_pool", bench_insert_front<PoolStorage>,
+     {1'000, 10'000}},
+    {"resource_handle::insert_front_inline", bench_insert_front<InlineStorage>,
+     {1'000, 10'000}},
+    {"resource_handle::sort_heap", bench_sort<HeapStorage>, {1'000, 100'000}},
+    {"resource_handle::sort_pool", bench_sort<PoolStorage>, {1'000, 100'000}},
+    {"resource_handle::sort_inline", bench_sort<InlineStorage>,
+     {1'000, 100'000}},
+};
+
+} // namespace resource_handle
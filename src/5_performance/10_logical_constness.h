@@ -0,0 +1,148 @@
+#ifndef logical_constness_h
+#define logical_constness_h
+
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+
+namespace logical_constness {
+
+// ____________________________________________________________________________
+// Logical constness and threads
+/*
+The standard library assumes that const member functions can be called
+concurrently on the same object, as if they were reads. A const member
+function that modifies a mutable member, as
+classes::ConstAndLogicalConstnes::value(), breaks that assumption: two threads
+reading a shared const object race on the mutable member.
+
+The mutable members below keep const member functions safe to call
+concurrently:
+- MutableStat, a counter incremented by readers
+- LazyCached, a value computed by the first reader and shared by the others
+Non-const member functions (reset) still require exclusive access, as for any
+other member
+*/
+
+// Bytes of a cache line. std::hardware_destructive_interference_size is not
+// used because its value may change with compiler flags
+inline constexpr std::size_t cache_line{64};
+
+// ____________________________________________________________________________
+// MutableStat
+// A counter split into cache-line-sized shards: each thread increments the
+// shard assigned to it, so threads on different shards do not share cache
+// lines. Reading the value sums the shards
+
+template <std::size_t Shards = 16> class MutableStat {
+public:
+  MutableStat() = default;
+
+  MutableStat(MutableStat const &other) {
+    _shards[0].value.store(other.value(), std::memory_order_relaxed);
+  }
+
+  auto operator=(MutableStat const &other) -> MutableStat & {
+    auto const value{other.value()};
+    reset();
+    _shards[0].value.store(value, std::memory_order_relaxed);
+    return *this;
+  }
+
+  auto add(long amount = 1) const -> void {
+    _shards[shard_index() % Shards].value.fetch_add(amount,
+                                                    std::memory_order_relaxed);
+  }
+
+  // Exact once the concurrent calls to add have returned
+  auto value() const -> long {
+    long total{0};
+    for (auto const &shard : _shards) {
+      total += shard.value.load(std::memory_order_relaxed);
+    }
+    return total;
+  }
+
+  auto reset() -> void {
+    for (auto &shard : _shards) {
+      shard.value.store(0, std::memory_order_relaxed);
+    }
+  }
+
+private:
+  struct alignas(cache_line) Shard {
+    std::atomic<long> value{0};
+  };
+
+  mutable std::array<Shard, Shards> _shards{};
+
+  // Threads get consecutive indices in order of first use
+  static auto shard_index() -> std::size_t {
+    static constinit std::atomic<std::size_t> threads{0};
+    thread_local auto const index{
+        threads.fetch_add(1, std::memory_order_relaxed)};
+    return index;
+  }
+};
+
+// ____________________________________________________________________________
+// LazyCached
+// A value computed on the first call to get and then read without locking.
+// Concurrent first calls compute it once, the others wait for it
+
+template <typename T> class LazyCached {
+public:
+  LazyCached() = default;
+
+  LazyCached(LazyCached const &other) {
+    if (other._ready.load(std::memory_order_acquire)) {
+      _value = other._value;
+      _ready.store(true, std::memory_order_relaxed);
+    }
+  }
+
+  auto operator=(LazyCached const &other) -> LazyCached & {
+    if (this != &other) {
+      reset();
+      if (other._ready.load(std::memory_order_acquire)) {
+        _value = other._value;
+        _ready.store(true, std::memory_order_relaxed);
+      }
+    }
+    return *this;
+  }
+
+  template <std::invocable F> auto get(F &&compute) const -> T const & {
+    // Acquire: pairs with the release below, the value is visible when ready
+    if (!_ready.load(std::memory_order_acquire)) [[unlikely]] {
+      std::lock_guard lock{_mutex};
+      if (!_ready.load(std::memory_order_relaxed)) {
+        _value.emplace(compute());
+        _ready.store(true, std::memory_order_release);
+      }
+    }
+    return *_value;
+  }
+
+  auto has_value() const -> bool {
+    return _ready.load(std::memory_order_acquire);
+  }
+
+  // Invalidates the value, e.g. when the data it is computed from changes
+  auto reset() -> void {
+    _ready.store(false, std::memory_order_relaxed);
+    _value.reset();
+  }
+
+private:
+  mutable std::atomic<bool> _ready{false};
+  mutable std::mutex _mutex{};
+  mutable std::optional<T> _value{};
+};
+
+} // namespace logical_constness
+
+#endif
@@ -0,0 +1,175 @@
+#include "../header.h"
+#include "../runtime/thread_pool.h"
+#include "10_logical_constness.h"
+#include <atomic>
+#include <cctype>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace logical_constness {
+
+// Counts its reads and caches its word count: both from const member functions
+class Document {
+public:
+  explicit Document(std::string text) : _text{std::move(text)} {}
+
+  auto set_text(std::string text) -> void {
+    _text = std::move(text);
+    _words.reset();
+  }
+
+  auto words() const -> long {
+    _reads.add();
+    return _words.get([this] {
+      long words{0};
+      auto in_word{false};
+      for (auto const character : _text) {
+        auto const space{std::isspace(static_cast<unsigned char>(character))};
+        words += !in_word && !space;
+        in_word = !space;
+      }
+      return words;
+    });
+  }
+
+  auto reads() const -> long { return _reads.value(); }
+
+private:
+  std::string _text;
+  MutableStat<> _reads{};
+  LazyCached<long> _words{};
+};
+
+// ____________________________________________________________________________
+// Concurrent readers
+
+auto concurrent_readers() -> void {
+  TRACE_FUNCTION();
+  constexpr int threads{4};
+  constexpr int reads{1'000};
+  {
+    Document const document{"the quick brown fox"};
+    {
+      std::vector<std::jthread> readers{};
+      for (int i{0}; i < threads; ++i) {
+        readers.emplace_back([&document] {
+          for (int j{0}; j < reads; ++j) {
+            assert(document.words() == 4);
+          }
+        });
+      }
+    }
+    assert(document.reads() == threads * reads);
+  }
+  {
+    // Computed once
+    LazyCached<int> cached{};
+    std::atomic<int> computations{0};
+    {
+      std::vector<std::jthread> readers{};
+      for (int i{0}; i < threads; ++i) {
+        readers.emplace_back([&] {
+          assert(cached.get([&] { return ++computations; }) == 1);
+        });
+      }
+    }
+    assert(computations == 1);
+  }
+  {
+    // Modifying the object invalidates the cache
+    Document document{"one two"};
+    assert(document.words() == 2);
+    document.set_text("one two three");
+    assert(document.words() == 3);
+    assert(document.reads() == 2);
+  }
+}
+
+// ____________________________________________________________________________
+// Benchmarks
+// `arg` threads each counting 100'000 reads, or reading a cached value
+// 100'000 times, on a shared object. A single atomic or a mutex makes every
+// thread write the same cache line; the shards and the cached value, once
+// computed, are written by one thread or by none
+
+inline constexpr long operations_per_thread{100'000};
+
+template <typename Operation>
+auto contend(runtime::State &state, Operation const &operation) -> void {
+  auto const threads{static_cast<unsigned>(state.arg())};
+  runtime::ThreadPool pool{threads};
+  state.set_throughput("Mop", threads * operations_per_thread / 1e6);
+  for (auto _ : state) {
+    pool.parallel_for(threads, [&](std::size_t) {
+      for (long i{0}; i < operations_per_thread; ++i) {
+        operation();
+      }
+    });
+  }
+}
+
+auto bench_counter_atomic(runtime::State &state) -> void {
+  std::atomic<long> counter{0};
+  contend(state, [&] { counter.fetch_add(1, std::memory_order_relaxed); });
+  runtime::do_not_optimize(counter);
+}
+
+auto bench_counter_mutex(runtime::State &state) -> void {
+  std::mutex mutex{};
+  long counter{0};
+  contend(state, [&] {
+    std::lock_guard lock{mutex};
+    ++counter;
+  });
+  runtime::do_not_optimize(counter);
+}
+
+auto bench_counter_sharded(runtime::State &state) -> void {
+  // One shard per thread up to 64 threads
+  MutableStat<64> const counter{};
+  contend(state, [&] { counter.add(); });
+  runtime::do_not_optimize(counter.value());
+}
+
+auto bench_cached_mutex(runtime::State &state) -> void {
+  std::mutex mutex{};
+  std::optional<long> cached{};
+  contend(state, [&] {
+    std::lock_guard lock{mutex};
+    if (!cached) {
+      cached = 42;
+    }
+    runtime::do_not_optimize(*cached);
+  });
+}
+
+auto bench_cached_lazy(runtime::State &state) -> void {
+  LazyCached<long> const cached{};
+  contend(state,
+          [&] { runtime::do_not_optimize(cached.get([] { return 42l; })); });
+}
+
+// ____________________________________________________________________________
+
+auto run() -> void { concurrent_readers(); }
+
+runtime::ModuleRegistrar const registrar{"logical_constness", run};
+
+runtime::BenchmarkRegistrar const benchmarks[]{
+    {"logical_constness::counter_atomic", bench_counter_atomic,
+     {1, 2, 4, 8, 16, 32, 64}},
+    {"logical_constness::counter_mutex", bench_counter_mutex,
+     {1, 2, 4, 8, 16, 32, 64}},
+    {"logical_constness::counter_sharded", bench_counter_sharded,
+     {1, 2, 4, 8, 16, 32, 64}},
+    {"logical_constness::cached_mutex", bench_cached_mutex,
+     {1, 2, 4, 8, 16, 32, 64}},
+    {"logical_constness::cached_lazy", bench_cached_lazy,
+     {1, 2, 4, 8, 16, 32, 64}},
+};
+
+} // namespace logical_constness
@@ -0,0 +1,257 @@
+#ifndef compact_variant_h
+#define compact_variant_h
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace compact_variant {
+
+template <std::size_t I, typename... Ts>
+using Alternative = std::tuple_element_t<I, std::tuple<Ts...>>;
+
+template <typename T, typename... Ts>
+inline constexpr std::size_t count_of{(std::size_t{std::same_as<T, Ts>} + ... +
+                                       0)};
+
+// Index of the first T in Ts
+template <typename T, typename... Ts>
+inline constexpr std::size_t index_of{[] {
+  constexpr bool matches[]{std::same_as<T, Ts>...};
+  return static_cast<std::size_t>(std::ranges::find(matches, true) -
+                                  std::begin(matches));
+}()};
+
+// ____________________________________________________________________________
+// Encodings
+/*
+Where a CompactVariant keeps its value and the index of its alternative.
+An encoding of Ts... provides:
+- Encoding(std::in_place_index<I>, value), value of type Alternative<I>
+- index()
+- get<I>(), the value, valid only if I is the index
+Values are trivially copyable: they are stored as bytes and returned by value
+*/
+
+// The value followed by a one-byte index. Bytes have no alignment, so
+// neither has the encoding: no padding after the index.
+// int or float: 5 bytes, std::variant<int, float> 8
+template <typename... Ts> class PackedTag {
+public:
+  template <std::size_t I>
+  PackedTag(std::in_place_index_t<I>, Alternative<I, Ts...> value)
+      : _index{static_cast<std::uint8_t>(I)} {
+    auto const bytes{std::bit_cast<Bytes<Alternative<I, Ts...>>>(value)};
+    std::ranges::copy(bytes, _storage);
+  }
+
+  auto index() const -> std::size_t { return _index; }
+
+  template <std::size_t I> auto get() const -> Alternative<I, Ts...> {
+    using T = Alternative<I, Ts...>;
+    Bytes<T> bytes;
+    std::copy_n(_storage, sizeof(T), bytes.begin());
+    return std::bit_cast<T>(bytes);
+  }
+
+private:
+  template <typename T> using Bytes = std::array<std::byte, sizeof(T)>;
+
+  std::byte _storage[std::max({sizeof(Ts)...})];
+  std::uint8_t _index;
+};
+
+// Pointers to objects aligned to N bytes have their log2(N) low bits always
+// zero: they hold the index.
+// Two pointers to long: 8 bytes, std::variant 16
+template <typename T> constexpr auto pointee_alignment() -> std::size_t {
+  if constexpr (std::is_pointer_v<T> &&
+                std::is_object_v<std::remove_pointer_t<T>>) {
+    return alignof(std::remove_pointer_t<T>);
+  } else {
+    return 0;
+  }
+}
+
+template <typename... Ts>
+inline constexpr bool pointer_taggable{sizeof...(Ts) <=
+                                       std::min({pointee_alignment<Ts>()...})};
+
+template <typename... Ts> class PointerTagged {
+  static_assert(pointer_taggable<Ts...>);
+
+public:
+  template <std::size_t I>
+  PointerTagged(std::in_place_index_t<I>, Alternative<I, Ts...> value)
+      : _word{reinterpret_cast<std::uintptr_t>(value) | I} {}
+
+  auto index() const -> std::size_t { return _word & tag_mask; }
+
+  template <std::size_t I> auto get() const -> Alternative<I, Ts...> {
+    return reinterpret_cast<Alternative<I, Ts...>>(_word & ~tag_mask);
+  }
+
+private:
+  static constexpr std::uintptr_t tag_mask{
+      std::min({pointee_alignment<Ts>()...}) - 1};
+
+  std::uintptr_t _word;
+};
+
+// A double, or any other alternative in the payload of a NaN. Doubles whose
+// exponent bits are all ones and whose top fraction bit is set are quiet
+// NaNs: with the sign bit, they leave 51 bits free, 3 for the index and 48
+// for the value. NaN doubles are stored as one canonical, positive NaN, so
+// that a negative quiet NaN is always a boxed alternative.
+// Pointers are not boxed: user-space addresses exceed 48 bits with 5-level
+// paging on x86-64 and 52-bit addresses on AArch64, and a variant of a
+// double and a pointer uses PackedTag.
+// double, int, float or bool: 8 bytes, std::variant 16
+template <typename T>
+inline constexpr bool boxable{
+    std::is_trivially_copyable_v<T> && !std::is_pointer_v<T> &&
+    (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4)};
+
+template <typename... Ts>
+inline constexpr bool nan_boxable{
+    std::numeric_limits<double>::is_iec559 && sizeof...(Ts) <= 8 &&
+    count_of<double, Ts...> == 1 &&
+    ((std::same_as<Ts, double> || boxable<Ts>) && ...)};
+
+template <typename... Ts> class NanBoxed {
+  static_assert(nan_boxable<Ts...>);
+
+public:
+  template <std::size_t I>
+  NanBoxed(std::in_place_index_t<I>, Alternative<I, Ts...> value) {
+    using T = Alternative<I, Ts...>;
+    if constexpr (I == double_index) {
+      _word = std::isnan(value) ? canonical_nan
+                                : std::bit_cast<std::uint64_t>(value);
+    } else {
+      _word = boxed | std::uint64_t{I} << tag_shift |
+              std::bit_cast<Bits<sizeof(T)>>(value);
+    }
+  }
+
+  auto index() const -> std::size_t {
+    return (_word & boxed) == boxed ? (_word >> tag_shift) & 0b111
+                                    : double_index;
+  }
+
+  template <std::size_t I> auto get() const -> Alternative<I, Ts...> {
+    using T = Alternative<I, Ts...>;
+    if constexpr (I == double_index) {
+      return std::bit_cast<double>(_word);
+    } else {
+      return std::bit_cast<T>(static_cast<Bits<sizeof(T)>>(_word));
+    }
+  }
+
+private:
+  template <std::size_t Size>
+  using Bits = std::conditional_t<
+      Size == 1, std::uint8_t,
+      std::conditional_t<Size == 2, std::uint16_t, std::uint32_t>>;
+
+  static constexpr std::size_t double_index{index_of<double, Ts...>};
+  // Sign, exponent and quiet bit
+  static constexpr std::uint64_t boxed{0xFFF8'0000'0000'0000};
+  static constexpr std::uint64_t canonical_nan{0x7FF8'0000'0000'0000};
+  static constexpr int tag_shift{48};
+
+  std::uint64_t _word;
+};
+
+// The smallest encoding that applies
+template <typename... Ts>
+using Encoding =
+    std::conditional_t<pointer_taggable<Ts...>, PointerTagged<Ts...>,
+                       std::conditional_t<nan_boxable<Ts...>, NanBoxed<Ts...>,
+                                          PackedTag<Ts...>>>;
+
+// ____________________________________________________________________________
+// Compact variant
+// A tagged union of trivially copyable types whose index, where possible, is
+// stored in bits the alternatives do not use. Alternatives are read by value:
+// there is no reference to the stored object, which may not exist as such
+
+template <typename... Ts>
+  requires(sizeof...(Ts) > 0 && sizeof...(Ts) <= 256 &&
+           (std::is_trivially_copyable_v<Ts> && ...) &&
+           ((count_of<Ts, Ts...> == 1) && ...))
+class CompactVariant {
+public:
+  // The first alternative, value-initialized
+  CompactVariant()
+    requires std::default_initializable<Alternative<0, Ts...>>
+      : CompactVariant{std::in_place_index<0>, Alternative<0, Ts...>{}} {}
+
+  template <std::size_t I>
+  explicit CompactVariant(std::in_place_index_t<I> index,
+                          Alternative<I, Ts...> value)
+      : _encoding{index, value} {}
+
+  // Only from one of the alternatives: no conversions
+  template <typename T>
+    requires(count_of<T, Ts...> == 1)
+  CompactVariant(T value)
+      : CompactVariant{std::in_place_index<index_of<T, Ts...>>, value} {}
+
+  auto index() const -> std::size_t { return _encoding.index(); }
+
+  template <typename T> auto holds_alternative() const -> bool {
+    return index() == index_of<T, Ts...>;
+  }
+
+  template <typename T> auto get() const -> T {
+    if (!holds_alternative<T>()) {
+      throw std::bad_variant_access{};
+    }
+    return _encoding.template get<index_of<T, Ts...>>();
+  }
+
+  // Undefined unless I is the index
+  template <std::size_t I>
+  auto get_unchecked() const -> Alternative<I, Ts...> {
+    return _encoding.template get<I>();
+  }
+
+private:
+  Encoding<Ts...> _encoding;
+};
+
+template <typename F, typename... Ts>
+using VisitResult = std::invoke_result_t<F &, Alternative<0, Ts...>>;
+
+template <std::size_t I, typename F, typename... Ts>
+auto call_alternative(F &function, CompactVariant<Ts...> const &variant)
+    -> VisitResult<F, Ts...> {
+  return std::invoke(function, variant.template get_unchecked<I>());
+}
+
+// One table of function pointers per (function, variant) pair, indexed by the
+// active alternative. Every alternative must give the same result type
+template <typename F, typename... Ts>
+auto visit(F &&function, CompactVariant<Ts...> const &variant)
+    -> VisitResult<F, Ts...> {
+  return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+    constexpr std::array table{&call_alternative<Is, F, Ts...>...};
+    return table[variant.index()](function, variant);
+  }(std::index_sequence_for<Ts...>{});
+}
+
+} // namespace compact_variant
+
+#endif
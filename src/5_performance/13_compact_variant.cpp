@@ -0,0 +1,274 @@
+#include "../header.h"
+#include "12_compact_variant.h"
+#include <cmath>
+#include <limits>
+#include <random>
+#include <variant>
+#include <vector>
+
+namespace compact_variant {
+
+// ____________________________________________________________________________
+// Encodings
+
+struct Integer {
+  long value;
+};
+
+struct Real {
+  double value;
+};
+
+using Number = CompactVariant<double, int, float, bool>;
+using SmallNumber = CompactVariant<int, float>;
+using Node = CompactVariant<Integer const *, Real const *>;
+
+static_assert(std::same_as<Encoding<double, int, float, bool>,
+                           NanBoxed<double, int, float, bool>>);
+static_assert(std::same_as<Encoding<int, float>, PackedTag<int, float>>);
+static_assert(std::same_as<Encoding<double, Real const *>,
+                           PackedTag<double, Real const *>>);
+static_assert(std::same_as<Encoding<Integer const *, Real const *>,
+                           PointerTagged<Integer const *, Real const *>>);
+
+auto encodings() -> void {
+  TRACE_FUNCTION();
+  {
+    // NaN boxing: the size of a double
+    static_assert(sizeof(Number) == sizeof(double));
+    static_assert(sizeof(std::variant<double, int, float, bool>) ==
+                  2 * sizeof(double));
+
+    Number number{1.5};
+    assert(number.holds_alternative<double>());
+    assert(number.get<double>() == 1.5);
+    number = -7;
+    assert(number.index() == 1);
+    assert(number.get<int>() == -7);
+    number = 0.5f;
+    assert(number.get<float>() == 0.5f);
+    number = true;
+    assert(number.get<bool>());
+
+    // Every NaN is a double, whatever its sign and payload
+    number = -std::numeric_limits<double>::quiet_NaN();
+    assert(number.holds_alternative<double>());
+    assert(std::isnan(number.get<double>()));
+    number = -std::numeric_limits<double>::infinity();
+    assert(number.get<double>() == -std::numeric_limits<double>::infinity());
+  }
+  {
+    // Packed tag: no padding after the index
+    static_assert(sizeof(SmallNumber) == sizeof(int) + 1);
+    static_assert(alignof(SmallNumber) == 1);
+    static_assert(sizeof(std::variant<int, float>) == 2 * sizeof(int));
+
+    SmallNumber number{42};
+    assert(number.get<int>() == 42);
+    number = 2.5f;
+    assert(number.get<float>() == 2.5f);
+    auto thrown{false};
+    try {
+      number.get<int>();
+    } catch (std::bad_variant_access const &) {
+      thrown = true;
+    }
+    assert(thrown);
+  }
+  {
+    // Pointer tagging: the size of a pointer
+    static_assert(sizeof(Node) == sizeof(void *));
+
+    Integer const integer{3};
+    Real const real{0.25};
+    Node node{&integer};
+    assert(node.get<Integer const *>()->value == 3);
+    node = &real;
+    assert(node.get<Real const *>() == &real);
+  }
+  {
+    // visit
+    auto const to_double{[](auto value) { return static_cast<double>(value); }};
+    assert(visit(to_double, Number{2}) == 2.0);
+    assert(visit(to_double, SmallNumber{0.5f}) == 0.5);
+  }
+}
+
+// ____________________________________________________________________________
+// Benchmarks
+// Visiting arrays of numbers stored as CompactVariant and std::variant, with
+// alternatives in random order. Bytes per element:
+// - double, int, float or bool: 8 (NaN boxing) against 16
+// - int or float: 5 (packed tag) against 8
+// - pointer to Integer or Real: 8 (pointer tagging) against 16
+
+template <typename Variant> auto make_numbers(long count) {
+  std::mt19937 generator{42};
+  std::uniform_int_distribution<int> alternative{0, 3};
+  std::vector<Variant> numbers{};
+  numbers.reserve(static_cast<std::size_t>(count));
+  for (long i{0}; i < count; ++i) {
+    switch (alternative(generator)) {
+    case 0:
+      numbers.emplace_back(static_cast<double>(i) / 2);
+      break;
+    case 1:
+      numbers.emplace_back(static_cast<int>(i));
+      break;
+    case 2:
+      numbers.emplace_back(static_cast<float>(i) / 4);
+      break;
+    default:
+      numbers.emplace_back(i % 2 == 0);
+      break;
+    }
+  }
+  return numbers;
+}
+
+template <typename Variant> auto make_small_numbers(long count) {
+  std::mt19937 generator{42};
+  std::bernoulli_distribution integer{0.5};
+  std::vector<Variant> numbers{};
+  numbers.reserve(static_cast<std::size_t>(count));
+  for (long i{0}; i < count; ++i) {
+    if (integer(generator)) {
+      numbers.emplace_back(static_cast<int>(i));
+    } else {
+      numbers.emplace_back(static_cast<float>(i) / 4);
+    }
+  }
+  return numbers;
+}
+
+inline constexpr auto as_double{
+    [](auto value) { return static_cast<double>(value); }};
+
+inline constexpr auto node_value{
+    [](auto node) { return static_cast<double>(node->value); }};
+
+auto bench_numbers_std(runtime::State &state) -> void {
+  auto const numbers{
+      make_numbers<std::variant<double, int, float, bool>>(state.arg())};
+  state.set_throughput("Melem", state.arg() / 1e6);
+  for (auto _ : state) {
+    double total{0};
+    for (auto const &number : numbers) {
+      total += std::visit(as_double, number);
+    }
+    runtime::do_not_optimize(total);
+  }
+}
+
+auto bench_numbers_compact(runtime::State &state) -> void {
+  auto const numbers{make_numbers<Number>(state.arg())};
+  state.set_throughput("Melem", state.arg() / 1e6);
+  for (auto _ : state) {
+    double total{0};
+    for (auto const &number : numbers) {
+      total += visit(as_double, number);
+    }
+    runtime::do_not_optimize(total);
+  }
+}
+
+auto bench_small_numbers_std(runtime::State &state) -> void {
+  auto const numbers{make_small_numbers<std::variant<int, float>>(state.arg())};
+  state.set_throughput("Melem", state.arg() / 1e6);
+  for (auto _ : state) {
+    double total{0};
+    for (auto const &number : numbers) {
+      total += std::visit(as_double, number);
+    }
+    runtime::do_not_optimize(total);
+  }
+}
+
+auto bench_small_numbers_compact(runtime::State &state) -> void {
+  auto const numbers{make_small_numbers<SmallNumber>(state.arg())};
+  state.set_throughput("Melem", state.arg() / 1e6);
+  for (auto _ : state) {
+    double total{0};
+    for (auto const &number : numbers) {
+      total += visit(as_double, number);
+    }
+    runtime::do_not_optimize(total);
+  }
+}
+
+// The integers and the reals each in an array of their own
+struct Nodes {
+  std::vector<Integer> integers{};
+  std::vector<Real> reals{};
+
+  explicit Nodes(long count) {
+    for (long i{0}; i < count; ++i) {
+      integers.push_back({i});
+      reals.push_back({static_cast<double>(i) / 2});
+    }
+  }
+
+  template <typename Variant> auto pointers() const {
+    std::mt19937 generator{42};
+    std::bernoulli_distribution integer{0.5};
+    std::vector<Variant> pointers{};
+    pointers.reserve(integers.size());
+    for (std::size_t i{0}; i < integers.size(); ++i) {
+      if (integer(generator)) {
+        pointers.emplace_back(&integers[i]);
+      } else {
+        pointers.emplace_back(&reals[i]);
+      }
+    }
+    return pointers;
+  }
+};
+
+auto bench_nodes_std(runtime::State &state) -> void {
+  Nodes const nodes{state.arg()};
+  auto const pointers{
+      nodes.pointers<std::variant<Integer const *, Real const *>>()};
+  state.set_throughput("Melem", state.arg() / 1e6);
+  for (auto _ : state) {
+    double total{0};
+    for (auto const &pointer : pointers) {
+      total += std::visit(node_value, pointer);
+    }
+    runtime::do_not_optimize(total);
+  }
+}
+
+auto bench_nodes_compact(runtime::State &state) -> void {
+  Nodes const nodes{state.arg()};
+  auto const pointers{nodes.pointers<Node>()};
+  state.set_throughput("Melem", state.arg() / 1e6);
+  for (auto _ : state) {
+    double total{0};
+    for (auto const &pointer : pointers) {
+      total += visit(node_value, pointer);
+    }
+    runtime::do_not_optimize(total);
+  }
+}
+
+// ____________________________________________________________________________
+
+auto run() -> void { encodings(); }
+
+runtime::ModuleRegistrar const registrar{"compact_variant", run};
+
+runtime::BenchmarkRegistrar const benchmarks[]{
+    {"compact_variant::numbers_std", bench_numbers_std,
+     {1'000'000, 10'000'000}},
+    {"compact_variant::numbers_compact", bench_numbers_compact,
+     {1'000'000, 10'000'000}},
+    {"compact_variant::small_numbers_std", bench_small_numbers_std,
+     {1'000'000, 10'000'000}},
+    {"compact_variant::small_numbers_compact", bench_small_numbers_compact,
+     {1'000'000, 10'000'000}},
+    {"compact_variant::nodes_std", bench_nodes_std, {1'000'000, 10'000'000}},
+    {"compact_variant::nodes_compact", bench_nodes_compact,
+     {1'000'000, 10'000'000}},
+};
+
+} // namespace compact_variant
@@ -0,0 +1,149 @@
+#ifndef simd_vector_h
+#define simd_vector_h
+
+#include "26_bounds_check.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+
+namespace simd_vector {
+
+// ____________________________________________________________________________
+// SIMD vector
+/*
+operators::Vector generalized to N components of type T, laid out for SIMD
+registers: the components are stored in an array of `lanes` elements, N
+rounded up to a power of two, aligned to its size. The lanes past N are
+padding and always zero, so that they do not change comparisons, dot
+products and norms.
+
+Every operation is a loop over all the lanes, with a trip count known at
+compile time and no dependency between lanes: GCC and Clang vectorize it
+with the widest instructions of the target (one SSE instruction for 4 floats,
+two for 8, one AVX instruction with -mavx). The compiler vector extensions
+(`__attribute__((vector_size))`) give the same instructions for arithmetic,
+but GCC splits comparisons and selects on vectors wider than the target
+registers into scalar code; plain loops do not have that cliff
+*/
+
+template <typename T>
+concept Component = std::same_as<T, float> || std::same_as<T, double> ||
+                    std::same_as<T, std::int32_t>;
+
+// Indexing throws std::out_of_range past N, as operators::Vector, unless
+// Bounds is another policy
+template <Component T, std::size_t N,
+          bounds_check::Policy Bounds = bounds_check::Checked>
+  requires(N >= 2 && N <= 16)
+class Vector {
+public:
+  using value_type = T;
+  static constexpr std::size_t size{N};
+  static constexpr std::size_t lanes{std::bit_ceil(N)};
+
+  // All zeros
+  Vector() = default;
+
+  template <std::convertible_to<T>... Us>
+    requires(sizeof...(Us) == N)
+  Vector(Us... components) : _lanes{static_cast<T>(components)...} {}
+
+  // prefix, adds one to each component
+  auto operator++() -> Vector & {
+    for (std::size_t i{0}; i < lanes; ++i) {
+      _lanes[i] += ones[i];
+    }
+    return *this;
+  }
+
+  // postfix (dummy argument)
+  auto operator++(int) -> Vector {
+    auto old{*this};
+    ++*this;
+    return old;
+  }
+
+  auto operator[](std::size_t index) const -> T {
+    Bounds::check(index, N);
+    return _lanes[index];
+  }
+
+  auto operator[](std::size_t index) -> T & {
+    Bounds::check(index, N);
+    return _lanes[index];
+  }
+
+  friend auto operator+=(Vector &lhs, Vector const &rhs) -> Vector & {
+    for (std::size_t i{0}; i < lanes; ++i) {
+      lhs._lanes[i] += rhs._lanes[i];
+    }
+    return lhs;
+  }
+
+  friend auto operator+(Vector const &lhs, Vector const &rhs) -> Vector {
+    auto vector{lhs};
+    vector += rhs;
+    return vector;
+  }
+
+  friend auto operator==(Vector const &lhs, Vector const &rhs)
+      -> bool = default;
+
+  // Lexicographic: partial ordering for floating-point components
+  friend auto operator<=>(Vector const &lhs, Vector const &rhs) = default;
+
+  friend auto dot(Vector const &lhs, Vector const &rhs) -> T {
+    Lanes products{};
+    for (std::size_t i{0}; i < lanes; ++i) {
+      products[i] = lhs._lanes[i] * rhs._lanes[i];
+    }
+    // In order: floating-point additions are not associative
+    T total{0};
+    for (std::size_t i{0}; i < N; ++i) {
+      total += products[i];
+    }
+    return total;
+  }
+
+  // double for int32_t components
+  friend auto norm(Vector const &vector) {
+    return std::sqrt(dot(vector, vector));
+  }
+
+  // Component-wise
+  friend auto min(Vector const &lhs, Vector const &rhs) -> Vector {
+    Vector vector{};
+    for (std::size_t i{0}; i < lanes; ++i) {
+      vector._lanes[i] = std::min(lhs._lanes[i], rhs._lanes[i]);
+    }
+    return vector;
+  }
+
+  friend auto max(Vector const &lhs, Vector const &rhs) -> Vector {
+    Vector vector{};
+    for (std::size_t i{0}; i < lanes; ++i) {
+      vector._lanes[i] = std::max(lhs._lanes[i], rhs._lanes[i]);
+    }
+    return vector;
+  }
+
+private:
+  using Lanes = std::array<T, lanes>;
+
+  static constexpr Lanes ones{[] {
+    Lanes ones{};
+    std::fill_n(ones.begin(), N, T{1});
+    return ones;
+  }()};
+
+  alignas(sizeof(Lanes)) Lanes _lanes{};
+};
+
+} // namespace simd_vector
+
+#endif
@@ -0,0 +1,173 @@
+#include "../header.h"
+#include "../1_basics/08_operators.h"
+#include "14_simd_vector.h"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace simd_vector {
+
+// ____________________________________________________________________________
+// Operators
+
+auto same_operators() -> void {
+  TRACE_FUNCTION();
+  {
+    Vector<std::int32_t, 2> v1{3, 1};
+    auto v2{v1++};
+    assert(v2 == (Vector<std::int32_t, 2>{3, 1}));
+    assert(v1 == (Vector<std::int32_t, 2>{4, 2}));
+    assert((++v1 == Vector<std::int32_t, 2>{5, 3}));
+  }
+  {
+    Vector<float, 3> v1{1, 2, 3};
+    Vector<float, 3> const v2{10, 20, 30};
+    v1 += v2;
+    assert(v1[0] == 11 && v1[1] == 22 && v1[2] == 33);
+    assert(v1 + v2 == (Vector<float, 3>{21, 42, 63}));
+
+    v1[2] = 0;
+    assert(v1[2] == 0);
+    auto throwed{false};
+    try {
+      v1[3] = 0; // a padding lane, but out of range
+    } catch (std::out_of_range const &) {
+      throwed = true;
+    }
+    assert(throwed);
+  }
+  {
+    // Lexicographic ordering
+    using Vector2 = Vector<std::int32_t, 2>;
+    assert((Vector2{3, 1} <=> Vector2{3, 2}) < 0);
+    assert((Vector2{4, 0} <=> Vector2{3, 2}) > 0);
+
+    auto const nan{std::numeric_limits<double>::quiet_NaN()};
+    assert((Vector<double, 2>{nan, 0} <=> Vector<double, 2>{0, 0}) ==
+           std::partial_ordering::unordered);
+  }
+}
+
+auto new_operations() -> void {
+  TRACE_FUNCTION();
+  Vector<double, 5> const v1{1, 2, 3, 4, 5};
+  Vector<double, 5> const v2{5, 4, 3, 2, 1};
+  assert(dot(v1, v2) == 5 + 8 + 9 + 8 + 5);
+  assert(norm(Vector<std::int32_t, 2>{3, 4}) == 5.0);
+  assert(min(v1, v2) == (Vector<double, 5>{1, 2, 3, 2, 1}));
+  assert(max(v1, v2) == (Vector<double, 5>{5, 4, 3, 4, 5}));
+
+  Vector<float, 16> v3{};
+  ++v3;
+  assert(dot(v3, v3) == 16);
+}
+
+// ____________________________________________________________________________
+// Benchmarks
+// Batch transforms of points: translating every point, and the bounding box
+// of the points. operators::Vector against Vector of 2 to 8 components
+
+template <typename Point> auto make_points(long count) -> std::vector<Point> {
+  std::vector<Point> points{};
+  points.reserve(static_cast<std::size_t>(count));
+  for (long i{0}; i < count; ++i) {
+    if constexpr (std::same_as<Point, operators::Vector>) {
+      points.emplace_back(static_cast<int>(i), static_cast<int>(i % 1'000));
+    } else {
+      Point point{};
+      for (std::size_t j{0}; j < Point::size; ++j) {
+        point[j] = static_cast<typename Point::value_type>((i + j) % 1'000);
+      }
+      points.push_back(point);
+    }
+  }
+  return points;
+}
+
+template <typename Point> auto one() -> Point {
+  if constexpr (std::same_as<Point, operators::Vector>) {
+    return {1, 1};
+  } else {
+    Point point{};
+    return ++point;
+  }
+}
+
+template <typename Point> auto bench_translate(runtime::State &state) -> void {
+  auto points{make_points<Point>(state.arg())};
+  auto const offset{one<Point>()};
+  state.set_throughput("Mpoint", state.arg() / 1e6);
+  for (auto _ : state) {
+    for (auto &point : points) {
+      point += offset;
+    }
+    runtime::do_not_optimize(points.data());
+  }
+}
+
+auto bench_bounds_scalar(runtime::State &state) -> void {
+  auto const points{make_points<operators::Vector>(state.arg())};
+  state.set_throughput("Mpoint", state.arg() / 1e6);
+  for (auto _ : state) {
+    operators::Vector lower{points.front()};
+    operators::Vector upper{points.front()};
+    for (auto const &point : points) {
+      lower.x = std::min(lower.x, point.x);
+      lower.y = std::min(lower.y, point.y);
+      upper.x = std::max(upper.x, point.x);
+      upper.y = std::max(upper.y, point.y);
+    }
+    runtime::do_not_optimize(lower);
+    runtime::do_not_optimize(upper);
+  }
+}
+
+template <typename Point> auto bench_bounds(runtime::State &state) -> void {
+  auto const points{make_points<Point>(state.arg())};
+  state.set_throughput("Mpoint", state.arg() / 1e6);
+  for (auto _ : state) {
+    auto lower{points.front()};
+    auto upper{points.front()};
+    for (auto const &point : points) {
+      lower = min(lower, point);
+      upper = max(upper, point);
+    }
+    runtime::do_not_optimize(lower);
+    runtime::do_not_optimize(upper);
+  }
+}
+
+// ____________________________________________________________________________
+
+auto run() -> void {
+  same_operators();
+  new_operations();
+}
+
+runtime::ModuleRegistrar const registrar{"simd_vector", run};
+
+runtime::BenchmarkRegistrar const benchmarks[]{
+    {"simd_vector::translate_scalar_int2", bench_translate<operators::Vector>,
+     {1'000, 1'000'000}},
+    {"simd_vector::translate_int2", bench_translate<Vector<std::int32_t, 2>>,
+     {1'000, 1'000'000}},
+    {"simd_vector::translate_int4", bench_translate<Vector<std::int32_t, 4>>,
+     {1'000, 1'000'000}},
+    {"simd_vector::translate_float4", bench_translate<Vector<float, 4>>,
+     {1'000, 1'000'000}},
+    {"simd_vector::translate_float8", bench_translate<Vector<float, 8>>,
+     {1'000, 1'000'000}},
+    {"simd_vector::translate_double4", bench_translate<Vector<double, 4>>,
+     {1'000, 1'000'000}},
+    {"simd_vector::bounds_scalar_int2", bench_bounds_scalar,
+     {1'000, 1'000'000}},
+    {"simd_vector::bounds_int2", bench_bounds<Vector<std::int32_t, 2>>,
+     {1'000, 1'000'000}},
+    {"simd_vector::bounds_float4", bench_bounds<Vector<float, 4>>,
+     {1'000, 1'000'000}},
+    {"simd_vector::bounds_float8", bench_bounds<Vector<float, 8>>,
+     {1'000, 1'000'000}},
+};
+
+} // namespace simd_vector
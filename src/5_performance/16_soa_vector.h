@@ -0,0 +1,240 @@
+#ifndef soa_vector_h
+#define soa_vector_h
+
+#include "26_bounds_check.h"
+#include <cstddef>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace soa_vector {
+
+// ____________________________________________________________________________
+// Fields of an aggregate
+/*
+The members of a class whose non-static data members are all public, found
+without reflection:
+- their number is the largest n for which T{x1, ..., xn} compiles, with
+  arguments convertible to any type
+- they are bound by reference with a structured binding of that many names
+Members that are arrays or aggregates are counted by their elements (brace
+elision): they are not supported. Up to 8 members
+*/
+
+struct AnyField {
+  // Only used in unevaluated contexts
+  template <typename T> operator T() const;
+};
+
+template <typename T, std::size_t... Is>
+constexpr auto brace_constructible(std::index_sequence<Is...>) -> bool {
+  return requires { T{(void(Is), AnyField{})...}; };
+}
+
+template <typename T, std::size_t N = 8> constexpr auto count_fields() {
+  if constexpr (N == 0 ||
+                brace_constructible<T>(std::make_index_sequence<N>{})) {
+    return N;
+  } else {
+    return count_fields<T, N - 1>();
+  }
+}
+
+template <typename T>
+inline constexpr std::size_t field_count{count_fields<T>()};
+
+// A tuple of references to the members of `object`
+template <typename T> auto tie_fields(T &object) {
+  constexpr auto count{field_count<std::remove_const_t<T>>};
+  static_assert(count > 0 && count <= 8, "unsupported class");
+  if constexpr (count == 1) {
+    auto &[a] = object;
+    return std::tie(a);
+  } else if constexpr (count == 2) {
+    auto &[a, b] = object;
+    return std::tie(a, b);
+  } else if constexpr (count == 3) {
+    auto &[a, b, c] = object;
+    return std::tie(a, b, c);
+  } else if constexpr (count == 4) {
+    auto &[a, b, c, d] = object;
+    return std::tie(a, b, c, d);
+  } else if constexpr (count == 5) {
+    auto &[a, b, c, d, e] = object;
+    return std::tie(a, b, c, d, e);
+  } else if constexpr (count == 6) {
+    auto &[a, b, c, d, e, f] = object;
+    return std::tie(a, b, c, d, e, f);
+  } else if constexpr (count == 7) {
+    auto &[a, b, c, d, e, f, g] = object;
+    return std::tie(a, b, c, d, e, f, g);
+  } else {
+    auto &[a, b, c, d, e, f, g, h] = object;
+    return std::tie(a, b, c, d, e, f, g, h);
+  }
+}
+
+template <typename Tuple> struct RemoveReferences;
+
+template <typename... Ts> struct RemoveReferences<std::tuple<Ts...>> {
+  using type = std::tuple<std::remove_cvref_t<Ts>...>;
+};
+
+// std::tuple of the member types of T
+template <typename T>
+using Fields = typename RemoveReferences<decltype(tie_fields(
+    std::declval<T &>()))>::type;
+
+template <typename T, std::size_t I>
+using Field = std::tuple_element_t<I, Fields<T>>;
+
+template <typename Tuple> struct VectorsOf;
+
+template <typename... Ts> struct VectorsOf<std::tuple<Ts...>> {
+  using type = std::tuple<std::vector<Ts>...>;
+};
+
+// One std::vector per member of T
+template <typename T> using Columns = typename VectorsOf<Fields<T>>::type;
+
+// ____________________________________________________________________________
+// Structure of arrays
+/*
+SoaVector<Aggregate> is a sequence of Aggregate stored as one std::vector
+per member: a loop over one member reads only that member, where a
+std::vector<Aggregate> loads every member of each element into the cache.
+
+Elements are not stored as Aggregate objects: v[i] is a proxy holding a
+reference to each member, that converts to an Aggregate, can be assigned
+one, and decomposes with structured bindings:
+
+  auto [x, y] = v[i]; // x and y refer to the elements of the columns
+  x = 10;             // modifies v
+
+column<I>() is the array of member I as a std::span, for vectorized loops.
+v[i] checks i with the Bounds policy
+*/
+
+template <typename Aggregate,
+          bounds_check::Policy Bounds = bounds_check::Default>
+class SoaVector;
+
+template <typename Aggregate, bool Const> class SoaReference {
+public:
+  template <std::size_t I>
+  using Element = std::conditional_t<Const, Field<Aggregate, I> const,
+                                     Field<Aggregate, I>> &;
+
+  template <std::size_t I> auto get() const -> Element<I> {
+    return std::get<I>(_columns)[_index];
+  }
+
+  operator Aggregate() const {
+    return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+      return Aggregate{get<Is>()...};
+    }(std::make_index_sequence<field_count<Aggregate>>{});
+  }
+
+  // Assigns the members, not the reference
+  auto operator=(Aggregate const &value) const -> SoaReference const &
+    requires(!Const)
+  {
+    [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+      auto const fields{tie_fields(value)};
+      ((get<Is>() = std::get<Is>(fields)), ...);
+    }(std::make_index_sequence<field_count<Aggregate>>{});
+    return *this;
+  }
+
+  // v[0] = v[1]: the implicit copy assignment is deleted by the reference
+  // member, and the one above needs a conversion, ambiguous without these
+  auto operator=(SoaReference const &other) const -> SoaReference const &
+    requires(!Const)
+  {
+    return *this = Aggregate(other);
+  }
+  auto operator=(SoaReference<Aggregate, !Const> const &other) const
+      -> SoaReference const &
+    requires(!Const)
+  {
+    return *this = Aggregate(other);
+  }
+
+  SoaReference(SoaReference const &) = default;
+
+private:
+  using ColumnsReference =
+      std::conditional_t<Const, Columns<Aggregate> const, Columns<Aggregate>>
+          &;
+
+  ColumnsReference _columns;
+  std::size_t _index;
+
+  SoaReference(ColumnsReference columns, std::size_t index)
+      : _columns{columns}, _index{index} {}
+
+  template <typename, bounds_check::Policy> friend class SoaVector;
+};
+
+template <typename Aggregate, bounds_check::Policy Bounds> class SoaVector {
+public:
+  using Reference = SoaReference<Aggregate, false>;
+  using ConstReference = SoaReference<Aggregate, true>;
+
+  auto size() const -> std::size_t { return std::get<0>(_columns).size(); }
+  auto empty() const -> bool { return size() == 0; }
+
+  auto reserve(std::size_t capacity) -> void {
+    std::apply([&](auto &...columns) { (columns.reserve(capacity), ...); },
+               _columns);
+  }
+
+  auto clear() -> void {
+    std::apply([](auto &...columns) { (columns.clear(), ...); }, _columns);
+  }
+
+  auto push_back(Aggregate const &value) -> void {
+    [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+      auto const fields{tie_fields(value)};
+      (std::get<Is>(_columns).push_back(std::get<Is>(fields)), ...);
+    }(std::make_index_sequence<field_count<Aggregate>>{});
+  }
+
+  auto operator[](std::size_t index) -> Reference {
+    Bounds::check(index, size());
+    return {_columns, index};
+  }
+  auto operator[](std::size_t index) const -> ConstReference {
+    Bounds::check(index, size());
+    return {_columns, index};
+  }
+
+  template <std::size_t I> auto column() -> std::span<Field<Aggregate, I>> {
+    return std::get<I>(_columns);
+  }
+  template <std::size_t I>
+  auto column() const -> std::span<Field<Aggregate, I> const> {
+    return std::get<I>(_columns);
+  }
+
+private:
+  Columns<Aggregate> _columns{};
+};
+
+} // namespace soa_vector
+
+// Structured bindings of the references
+template <typename Aggregate, bool Const>
+struct std::tuple_size<soa_vector::SoaReference<Aggregate, Const>>
+    : std::integral_constant<std::size_t,
+                             soa_vector::field_count<Aggregate>> {};
+
+template <std::size_t I, typename Aggregate, bool Const>
+struct std::tuple_element<I, soa_vector::SoaReference<Aggregate, Const>> {
+  using type = typename soa_vector::SoaReference<Aggregate,
+                                                 Const>::template Element<I>;
+};
+
+#endif
@@ -0,0 +1,196 @@
+#include "../header.h"
+#include "../1_basics/08_operators.h"
+#include "16_soa_vector.h"
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace soa_vector {
+
+struct Record {
+  int id;
+  std::string name;
+  double score;
+};
+
+static_assert(field_count<Record> == 3);
+static_assert(field_count<operators::Vector> == 2);
+static_assert(
+    std::same_as<Fields<Record>, std::tuple<int, std::string, double>>);
+
+// ____________________________________________________________________________
+// Structure of arrays
+
+auto structure_of_arrays() -> void {
+  TRACE_FUNCTION();
+  {
+    SoaVector<operators::Vector> vectors{};
+    vectors.push_back({3, 1});
+    vectors.push_back({4, 2});
+    assert(vectors.size() == 2);
+
+    // Structured bindings refer to the elements
+    auto [x, y] = vectors[1];
+    assert(x == 4 && y == 2);
+    x = 10;
+    operators::Vector const vector{vectors[1]};
+    assert(vector.x == 10 && vector.y == 2);
+
+    vectors[0] = operators::Vector{5, 6};
+    assert(vectors.column<0>()[0] == 5);
+    assert(vectors.column<1>()[0] == 6);
+
+    vectors[0] = vectors[1];
+    assert(vectors.column<0>()[0] == 10 && vectors.column<1>()[0] == 2);
+    auto const &constant{vectors};
+    vectors[1] = constant[0];
+    assert(vectors.column<0>()[1] == 10);
+  }
+  {
+    SoaVector<Record> records{};
+    records.push_back({1, "one", 0.5});
+    records.push_back({2, "two", 1.5});
+
+    auto const &constant{records};
+    auto const [id, name, score] = constant[1];
+    assert(id == 2 && name == "two" && score == 1.5);
+
+    auto const scores{records.column<2>()};
+    assert(std::accumulate(scores.begin(), scores.end(), 0.0) == 2.0);
+  }
+}
+
+// ____________________________________________________________________________
+// Benchmarks
+// Particles of 8 floats (32 bytes) as std::vector<Particle> and as
+// SoaVector<Particle>: a scan reading one member, a transform updating one
+// member, and an update reading 3 members and writing 3. Touching one member
+// out of 8, the array of structures loads 8 times the bytes it uses
+
+struct Particle {
+  float x, y, z;
+  float vx, vy, vz;
+  float mass;
+  float charge;
+};
+
+auto make_particle(long i) -> Particle {
+  auto const f{static_cast<float>(i % 1'000)};
+  return {f, f + 1, f + 2, 1, 2, 3, f / 1'000, -1};
+}
+
+auto make_aos(long count) -> std::vector<Particle> {
+  std::vector<Particle> particles{};
+  particles.reserve(static_cast<std::size_t>(count));
+  for (long i{0}; i < count; ++i) {
+    particles.push_back(make_particle(i));
+  }
+  return particles;
+}
+
+auto make_soa(long count) -> SoaVector<Particle> {
+  SoaVector<Particle> particles{};
+  particles.reserve(static_cast<std::size_t>(count));
+  for (long i{0}; i < count; ++i) {
+    particles.push_back(make_particle(i));
+  }
+  return particles;
+}
+
+auto bench_scan_aos(runtime::State &state) -> void {
+  auto const particles{make_aos(state.arg())};
+  state.set_throughput("Melem", state.arg() / 1e6);
+  for (auto _ : state) {
+    float total{0};
+    for (auto const &particle : particles) {
+      total += particle.mass;
+    }
+    runtime::do_not_optimize(total);
+  }
+}
+
+auto bench_scan_soa(runtime::State &state) -> void {
+  auto const particles{make_soa(state.arg())};
+  state.set_throughput("Melem", state.arg() / 1e6);
+  for (auto _ : state) {
+    float total{0};
+    for (auto const mass : particles.column<6>()) {
+      total += mass;
+    }
+    runtime::do_not_optimize(total);
+  }
+}
+
+auto bench_transform_aos(runtime::State &state) -> void {
+  auto particles{make_aos(state.arg())};
+  state.set_throughput("Melem", state.arg() / 1e6);
+  for (auto _ : state) {
+    for (auto &particle : particles) {
+      particle.charge = -particle.charge;
+    }
+    runtime::do_not_optimize(particles.data());
+  }
+}
+
+auto bench_transform_soa(runtime::State &state) -> void {
+  auto particles{make_soa(state.arg())};
+  state.set_throughput("Melem", state.arg() / 1e6);
+  for (auto _ : state) {
+    auto const charges{particles.column<7>()};
+    for (auto &charge : charges) {
+      charge = -charge;
+    }
+    runtime::do_not_optimize(charges.data());
+  }
+}
+
+auto bench_move_aos(runtime::State &state) -> void {
+  auto particles{make_aos(state.arg())};
+  state.set_throughput("Melem", state.arg() / 1e6);
+  for (auto _ : state) {
+    for (auto &particle : particles) {
+      particle.x += particle.vx;
+      particle.y += particle.vy;
+      particle.z += particle.vz;
+    }
+    runtime::do_not_optimize(particles.data());
+  }
+}
+
+auto bench_move_soa(runtime::State &state) -> void {
+  auto particles{make_soa(state.arg())};
+  state.set_throughput("Melem", state.arg() / 1e6);
+  for (auto _ : state) {
+    auto const x{particles.column<0>()};
+    auto const y{particles.column<1>()};
+    auto const z{particles.column<2>()};
+    auto const vx{particles.column<3>()};
+    auto const vy{particles.column<4>()};
+    auto const vz{particles.column<5>()};
+    for (std::size_t i{0}; i < x.size(); ++i) {
+      x[i] += vx[i];
+      y[i] += vy[i];
+      z[i] += vz[i];
+    }
+    runtime::do_not_optimize(x.data());
+  }
+}
+
+// ____________________________________________________________________________
+
+auto run() -> void { structure_of_arrays(); }
+
+runtime::ModuleRegistrar const registrar{"soa_vector", run};
+
+runtime::BenchmarkRegistrar const benchmarks[]{
+    {"soa_vector::scan_aos", bench_scan_aos, {10'000, 1'000'000, 10'000'000}},
+    {"soa_vector::scan_soa", bench_scan_soa, {10'000, 1'000'000, 10'000'000}},
+    {"soa_vector::transform_aos", bench_transform_aos,
+     {10'000, 1'000'000, 10'000'000}},
+    {"soa_vector::transform_soa", bench_transform_soa,
+     {10'000, 1'000'000, 10'000'000}},
+    {"soa_vector::move_aos", bench_move_aos, {10'000, 1'000'000, 10'000'000}},
+    {"soa_vector::move_soa", bench_move_soa, {10'000, 1'000'000, 10'000'000}},
+};
+
+} // namespace soa_vector
@@ -0,0 +1,60 @@
+#ifndef vector_codec_h
+#define vector_codec_h
+
+#include "../1_basics/08_operators.h"
+#include <cstddef>
+#include <span>
+
+namespace vector_codec {
+
+// ____________________________________________________________________________
+// Bulk codecs for operators::Vector
+/*
+operator<< and operator>> format and parse one integer at a time through a
+stream: locale, sentry and virtual calls for every number. These functions
+convert whole arrays of vectors from and to caller-provided buffers.
+
+Text: the format of operator<<, one vector per line, "x y\n". Decoding
+accepts any whitespace between numbers, as operator>>.
+Binary: x then y, 32-bit two's complement little-endian, 8 bytes per vector,
+whatever the byte order of the machine.
+
+Decoders throw std::invalid_argument, with the offset of the error, on
+malformed input
+*/
+
+using operators::Vector;
+
+// "-2147483648 -2147483648\n"
+inline constexpr std::size_t max_text_size{24};
+inline constexpr std::size_t binary_size{8};
+
+struct DecodeResult {
+  std::size_t vectors{}; // vectors decoded
+  std::size_t bytes{};   // bytes consumed
+};
+
+// Writes `vectors` to `buffer`, which must hold at least
+// vectors.size() * max_text_size characters, or throws std::invalid_argument.
+// Returns the characters written
+auto encode_text(std::span<Vector const> vectors, std::span<char> buffer)
+    -> std::size_t;
+
+// Decodes until `text` or `vectors` is exhausted
+auto decode_text(std::span<char const> text, std::span<Vector> vectors)
+    -> DecodeResult;
+
+// Writes `vectors` to `buffer`, which must hold at least
+// vectors.size() * binary_size bytes, or throws std::invalid_argument.
+// Returns the bytes written
+auto encode_binary(std::span<Vector const> vectors, std::span<std::byte> buffer)
+    -> std::size_t;
+
+// Decodes until `data` or `vectors` is exhausted. The size of `data` must be
+// a multiple of binary_size
+auto decode_binary(std::span<std::byte const> data, std::span<Vector> vectors)
+    -> DecodeResult;
+
+} // namespace vector_codec
+
+#endif
@@ -0,0 +1,420 @@
+#include "../header.h"
+#include "18_vector_codec.h"
+#include <charconv>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace vector_codec {
+
+static_assert(sizeof(int) == 4, "the binary format stores 32-bit integers");
+
+namespace {
+
+[[noreturn]] auto fail(char const *begin, char const *position) -> void {
+  throw std::invalid_argument{"invalid vector at offset " +
+                              std::to_string(position - begin)};
+}
+
+// Checked once, against the longest encoding, not in the loop
+auto check_capacity(std::size_t capacity, std::size_t required) -> void {
+  if (capacity < required) {
+    throw std::invalid_argument{"buffer of " + std::to_string(capacity) +
+                                " bytes, " + std::to_string(required) +
+                                " required"};
+  }
+}
+
+auto is_space(char c) -> bool {
+  return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' ||
+         c == '\f';
+}
+
+// Byte by byte, independent of the byte order of the machine: compilers
+// merge the four bytes into one load or store
+auto store(int value, std::byte *out) -> void {
+  auto const bits{static_cast<std::uint32_t>(value)};
+  for (int i{0}; i < 4; ++i) {
+    out[i] = static_cast<std::byte>(bits >> (8 * i));
+  }
+}
+
+auto load(std::byte const *in) -> int {
+  std::uint32_t bits{0};
+  for (int i{0}; i < 4; ++i) {
+    bits |= std::to_integer<std::uint32_t>(in[i]) << (8 * i);
+  }
+  return static_cast<int>(bits);
+}
+
+} // namespace
+
+// ____________________________________________________________________________
+// Text
+
+auto encode_text(std::span<Vector const> vectors, std::span<char> buffer)
+    -> std::size_t {
+  check_capacity(buffer.size(), vectors.size() * max_text_size);
+  auto *out{buffer.data()};
+  auto *const end{buffer.data() + buffer.size()};
+  for (auto const &vector : vectors) {
+    out = std::to_chars(out, end, vector.x).ptr;
+    *out++ = ' ';
+    out = std::to_chars(out, end, vector.y).ptr;
+    *out++ = '\n';
+  }
+  return static_cast<std::size_t>(out - buffer.data());
+}
+
+auto decode_text(std::span<char const> text, std::span<Vector> vectors)
+    -> DecodeResult {
+  auto const *const begin{text.data()};
+  auto const *const end{begin + text.size()};
+  auto const *position{begin};
+
+  auto const skip_spaces{[&] {
+    while (position != end && is_space(*position)) {
+      ++position;
+    }
+  }};
+  auto const parse{[&](int &value) {
+    skip_spaces();
+    auto const [next, error]{std::from_chars(position, end, value)};
+    if (error != std::errc{}) {
+      fail(begin, position);
+    }
+    position = next;
+  }};
+
+  std::size_t count{0};
+  for (; count < vectors.size(); ++count) {
+    skip_spaces();
+    if (position == end) {
+      break;
+    }
+    parse(vectors[count].x);
+    parse(vectors[count].y);
+  }
+  return {count, static_cast<std::size_t>(position - begin)};
+}
+
+// ____________________________________________________________________________
+// Binary
+
+auto encode_binary(std::span<Vector const> vectors, std::span<std::byte> buffer)
+    -> std::size_t {
+  check_capacity(buffer.size(), vectors.size() * binary_size);
+  auto *out{buffer.data()};
+  for (auto const &vector : vectors) {
+    store(vector.x, out);
+    store(vector.y, out + 4);
+    out += binary_size;
+  }
+  return vectors.size() * binary_size;
+}
+
+auto decode_binary(std::span<std::byte const> data, std::span<Vector> vectors)
+    -> DecodeResult {
+  if (data.size() % binary_size != 0) {
+    throw std::invalid_argument{"invalid vector at offset " +
+                                std::to_string(data.size() / binary_size *
+                                               binary_size)};
+  }
+  auto const count{std::min(data.size() / binary_size, vectors.size())};
+  auto const *in{data.data()};
+  for (std::size_t i{0}; i < count; ++i) {
+    vectors[i].x = load(in);
+    vectors[i].y = load(in + 4);
+    in += binary_size;
+  }
+  return {count, count * binary_size};
+}
+
+// ____________________________________________________________________________
+// Round trips
+
+auto round_trips() -> void {
+  TRACE_FUNCTION();
+  std::vector<Vector> const vectors{
+      {3, 1}, {-6, 2}, {2'147'483'647, -2'147'483'647 - 1}};
+  {
+    std::string text(vectors.size() * max_text_size, '\0');
+    text.resize(encode_text(vectors, text));
+    assert(text == "3 1\n-6 2\n2147483647 -2147483648\n");
+
+    // The same text as operator<<
+    std::ostringstream stream{};
+    for (auto vector : vectors) {
+      stream << vector << '\n';
+    }
+    assert(stream.str() == text);
+
+    std::vector<Vector> decoded(vectors.size(), Vector{0, 0});
+    auto const result{decode_text(text, decoded)};
+    assert(result.vectors == 3 && result.bytes == text.size() - 1);
+    assert(decoded == vectors);
+  }
+  {
+    // Any whitespace, stops when the output is full
+    std::string_view const text{" 1\t2\n\n3   4 5 6"};
+    std::vector<Vector> decoded(2, Vector{0, 0});
+    auto const result{decode_text(text, decoded)};
+    assert(result.vectors == 2 && text.substr(result.bytes) == " 5 6");
+    assert((decoded[1] == Vector{3, 4}));
+
+    auto thrown{false};
+    try {
+      decode_text(std::string_view{"1 2\n3 a"}, decoded);
+    } catch (std::invalid_argument const &error) {
+      thrown = std::string_view{error.what()}.ends_with("offset 6");
+    }
+    assert(thrown);
+  }
+  {
+    std::vector<std::byte> data(vectors.size() * binary_size);
+    assert(encode_binary(vectors, data) == data.size());
+    // Little-endian
+    assert(data[0] == std::byte{3} && data[1] == std::byte{0});
+    assert(data[16] == std::byte{0xFF} && data[19] == std::byte{0x7F});
+
+    std::vector<Vector> decoded(vectors.size(), Vector{0, 0});
+    assert(decode_binary(data, decoded).vectors == 3);
+    assert(decoded == vectors);
+  }
+  {
+    // Buffers too small for the longest encoding
+    auto thrown{false};
+    try {
+      std::string text(max_text_size, '\0');
+      encode_text(vectors, text);
+    } catch (std::invalid_argument const &error) {
+      thrown = std::string{error.what()} == "buffer of 24 bytes, 72 required";
+    }
+    assert(thrown);
+
+    thrown = false;
+    try {
+      std::vector<std::byte> data(binary_size);
+      encode_binary(vectors, data);
+    } catch (std::invalid_argument const &) {
+      thrown = true;
+    }
+    assert(thrown);
+  }
+}
+
+// ____________________________________________________________________________
+// Benchmarks
+// `arg` vectors of random coordinates, about 16 characters per vector as
+// text and 8 bytes as binary, in memory and through a file (in the page
+// cache). Throughput in bytes of text or binary data
+
+struct Workload {
+  std::vector<Vector> vectors{};
+  std::string text{};
+  std::vector<std::byte> binary{};
+
+  explicit Workload(long count) {
+    std::mt19937 generator{42};
+    std::uniform_int_distribution<int> coordinate{-1'000'000, 1'000'000};
+    vectors.reserve(static_cast<std::size_t>(count));
+    for (long i{0}; i < count; ++i) {
+      vectors.emplace_back(coordinate(generator), coordinate(generator));
+    }
+    text.resize(vectors.size() * max_text_size);
+    text.resize(encode_text(vectors, text));
+    binary.resize(vectors.size() * binary_size);
+    encode_binary(vectors, binary);
+  }
+
+  auto output() const -> std::vector<Vector> {
+    return std::vector<Vector>(vectors.size(), Vector{0, 0});
+  }
+};
+
+auto temporary_file(char const *name) -> std::filesystem::path {
+  return std::filesystem::temp_directory_path() / name;
+}
+
+auto bench_encode_text_iostream(runtime::State &state) -> void {
+  Workload workload{state.arg()};
+  state.set_throughput("GB", workload.text.size() / 1e9);
+  for (auto _ : state) {
+    std::ostringstream stream{};
+    for (auto &vector : workload.vectors) {
+      stream << vector << '\n';
+    }
+    runtime::do_not_optimize(stream);
+  }
+}
+
+auto bench_encode_text(runtime::State &state) -> void {
+  Workload const workload{state.arg()};
+  std::string buffer(workload.vectors.size() * max_text_size, '\0');
+  state.set_throughput("GB", workload.text.size() / 1e9);
+  for (auto _ : state) {
+    runtime::do_not_optimize(encode_text(workload.vectors, buffer));
+  }
+}
+
+auto bench_decode_text_iostream(runtime::State &state) -> void {
+  Workload const workload{state.arg()};
+  auto vectors{workload.output()};
+  state.set_throughput("GB", workload.text.size() / 1e9);
+  for (auto _ : state) {
+    state.pause_timing();
+    std::istringstream stream{workload.text};
+    state.resume_timing();
+    for (auto &vector : vectors) {
+      stream >> vector;
+    }
+    runtime::do_not_optimize(vectors.data());
+  }
+}
+
+auto bench_decode_text(runtime::State &state) -> void {
+  Workload const workload{state.arg()};
+  auto vectors{workload.output()};
+  state.set_throughput("GB", workload.text.size() / 1e9);
+  for (auto _ : state) {
+    runtime::do_not_optimize(decode_text(workload.text, vectors));
+  }
+}
+
+auto bench_encode_binary(runtime::State &state) -> void {
+  Workload const workload{state.arg()};
+  std::vector<std::byte> buffer(workload.binary.size());
+  state.set_throughput("GB", workload.binary.size() / 1e9);
+  for (auto _ : state) {
+    runtime::do_not_optimize(encode_binary(workload.vectors, buffer));
+  }
+}
+
+auto bench_decode_binary(runtime::State &state) -> void {
+  Workload const workload{state.arg()};
+  auto vectors{workload.output()};
+  state.set_throughput("GB", workload.binary.size() / 1e9);
+  for (auto _ : state) {
+    runtime::do_not_optimize(decode_binary(workload.binary, vectors));
+  }
+}
+
+auto bench_write_text_iostream(runtime::State &state) -> void {
+  Workload workload{state.arg()};
+  auto const path{temporary_file("about-c-plus-plus-vectors.txt")};
+  state.set_throughput("GB", workload.text.size() / 1e9);
+  for (auto _ : state) {
+    std::ofstream file{path};
+    for (auto &vector : workload.vectors) {
+      file << vector << '\n';
+    }
+  }
+  std::filesystem::remove(path);
+}
+
+auto bench_write_text(runtime::State &state) -> void {
+  Workload const workload{state.arg()};
+  auto const path{temporary_file("about-c-plus-plus-vectors.txt")};
+  std::string buffer(workload.vectors.size() * max_text_size, '\0');
+  state.set_throughput("GB", workload.text.size() / 1e9);
+  for (auto _ : state) {
+    auto const size{encode_text(workload.vectors, buffer)};
+    std::ofstream file{path, std::ios::binary};
+    file.write(buffer.data(), static_cast<std::streamsize>(size));
+  }
+  std::filesystem::remove(path);
+}
+
+auto bench_read_text_iostream(runtime::State &state) -> void {
+  Workload const workload{state.arg()};
+  auto const path{temporary_file("about-c-plus-plus-vectors.txt")};
+  std::ofstream{path, std::ios::binary} << workload.text;
+  auto vectors{workload.output()};
+  state.set_throughput("GB", workload.text.size() / 1e9);
+  for (auto _ : state) {
+    std::ifstream file{path};
+    for (auto &vector : vectors) {
+      file >> vector;
+    }
+    runtime::do_not_optimize(vectors.data());
+  }
+  std::filesystem::remove(path);
+}
+
+auto bench_read_text(runtime::State &state) -> void {
+  Workload const workload{state.arg()};
+  auto const path{temporary_file("about-c-plus-plus-vectors.txt")};
+  std::ofstream{path, std::ios::binary} << workload.text;
+  auto vectors{workload.output()};
+  std::string buffer(workload.text.size(), '\0');
+  state.set_throughput("GB", workload.text.size() / 1e9);
+  for (auto _ : state) {
+    std::ifstream file{path, std::ios::binary};
+    file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    runtime::do_not_optimize(decode_text(buffer, vectors));
+  }
+  std::filesystem::remove(path);
+}
+
+auto bench_write_binary(runtime::State &state) -> void {
+  Workload const workload{state.arg()};
+  auto const path{temporary_file("about-c-plus-plus-vectors.bin")};
+  std::vector<std::byte> buffer(workload.binary.size());
+  state.set_throughput("GB", workload.binary.size() / 1e9);
+  for (auto _ : state) {
+    encode_binary(workload.vectors, buffer);
+    std::ofstream file{path, std::ios::binary};
+    file.write(reinterpret_cast<char const *>(buffer.data()),
+               static_cast<std::streamsize>(buffer.size()));
+  }
+  std::filesystem::remove(path);
+}
+
+auto bench_read_binary(runtime::State &state) -> void {
+  Workload const workload{state.arg()};
+  auto const path{temporary_file("about-c-plus-plus-vectors.bin")};
+  std::ofstream{path, std::ios::binary}.write(
+      reinterpret_cast<char const *>(workload.binary.data()),
+      static_cast<std::streamsize>(workload.binary.size()));
+  auto vectors{workload.output()};
+  std::vector<std::byte> buffer(workload.binary.size());
+  state.set_throughput("GB", workload.binary.size() / 1e9);
+  for (auto _ : state) {
+    std::ifstream file{path, std::ios::binary};
+    file.read(reinterpret_cast<char *>(buffer.data()),
+              static_cast<std::streamsize>(buffer.size()));
+    runtime::do_not_optimize(decode_binary(buffer, vectors));
+  }
+  std::filesystem::remove(path);
+}
+
+// ____________________________________________________________________________
+
+auto run() -> void { round_trips(); }
+
+runtime::ModuleRegistrar const registrar{"vector_codec", run};
+
+runtime::BenchmarkRegistrar const benchmarks[]{
+    {"vector_codec::encode_text_iostream", bench_encode_text_iostream,
+     {10'000, 1'000'000}},
+    {"vector_codec::encode_text", bench_encode_text, {10'000, 1'000'000}},
+    {"vector_codec::decode_text_iostream", bench_decode_text_iostream,
+     {10'000, 1'000'000}},
+    {"vector_codec::decode_text", bench_decode_text, {10'000, 1'000'000}},
+    {"vector_codec::encode_binary", bench_encode_binary, {10'000, 1'000'000}},
+    {"vector_codec::decode_binary", bench_decode_binary, {10'000, 1'000'000}},
+    {"vector_codec::write_text_iostream", bench_write_text_iostream,
+     {10'000, 1'000'000}},
+    {"vector_codec::write_text", bench_write_text, {10'000, 1'000'000}},
+    {"vector_codec::read_text_iostream", bench_read_text_iostream,
+     {10'000, 1'000'000}},
+    {"vector_codec::read_text", bench_read_text, {10'000, 1'000'000}},
+    {"vector_codec::write_binary", bench_write_binary, {10'000, 1'000'000}},
+    {"vector_codec::read_binary", bench_read_binary, {10'000, 1'000'000}},
+};
+
+} // namespace vector_codec
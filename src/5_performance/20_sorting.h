@@ -0,0 +1,201 @@
+#ifndef sorting_h
+#define sorting_h
+
+#include "../runtime/thread_pool.h"
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace sorting {
+
+// ____________________________________________________________________________
+// LSD radix sort
+/*
+Sorts by an integer key, one byte at a time from the least significant: each
+pass counts the bytes, then moves every element to its bucket in a second
+buffer. Stable, O(n) per pass and without comparisons, against the
+O(n log n) comparisons of std::sort.
+
+Signed keys are sorted as unsigned with the sign bit flipped, which maps
+their order onto the unsigned order. A pass where every key has the same
+byte is skipped
+*/
+
+template <typename Key>
+concept RadixKey = std::integral<Key> && !std::same_as<Key, bool>;
+
+template <std::integral Key>
+constexpr auto to_unsigned(Key key) -> std::make_unsigned_t<Key> {
+  using Unsigned = std::make_unsigned_t<Key>;
+  auto const bits{static_cast<Unsigned>(key)};
+  if constexpr (std::is_signed_v<Key>) {
+    return bits ^ (Unsigned{1} << (sizeof(Key) * 8 - 1));
+  } else {
+    return bits;
+  }
+}
+
+template <typename T, typename KeyOf>
+  requires RadixKey<std::invoke_result_t<KeyOf &, T const &>>
+auto radix_sort(std::span<T> values, KeyOf key_of) -> void {
+  using Key = std::invoke_result_t<KeyOf &, T const &>;
+  constexpr std::size_t passes{sizeof(Key)};
+
+  if (values.size() < 2) {
+    return;
+  }
+
+  // The histograms of all the passes in one scan
+  std::array<std::array<std::size_t, 256>, passes> counts{};
+  for (auto const &value : values) {
+    auto const key{to_unsigned(key_of(value))};
+    for (std::size_t pass{0}; pass < passes; ++pass) {
+      ++counts[pass][(key >> (8 * pass)) & 0xFF];
+    }
+  }
+
+  std::vector<T> buffer(values.begin(), values.end());
+  std::span<T> source{values};
+  std::span<T> destination{buffer};
+  for (std::size_t pass{0}; pass < passes; ++pass) {
+    auto &count{counts[pass]};
+    if (std::ranges::find(count, values.size()) != count.end()) {
+      continue;
+    }
+
+    // Counts to the offsets of the buckets
+    std::size_t offset{0};
+    for (auto &bucket : count) {
+      offset += std::exchange(bucket, offset);
+    }
+    for (auto &value : source) {
+      auto const key{to_unsigned(key_of(value))};
+      destination[count[(key >> (8 * pass)) & 0xFF]++] = std::move(value);
+    }
+    std::swap(source, destination);
+  }
+
+  if (source.data() != values.data()) {
+    std::ranges::move(source, values.begin());
+  }
+}
+
+// ____________________________________________________________________________
+// Parallel merge sort
+/*
+Splits the values into one run per thread of the pool, sorts the runs with
+std::sort in parallel, then merges pairs of runs in rounds, back and forth
+between the values and a buffer. Every round is one parallel loop: when
+there are fewer pairs than threads, each merge is split into parts, found
+by binary search, that are merged independently.
+
+Not stable, as std::sort
+*/
+
+namespace detail {
+
+// Where slice `part` of `parts` starts in the sorted ranges `left` and
+// `right`: at an even split of `left`, and at the first element of `right`
+// not less than the element of `left` there. The first slice starts at the
+// beginning of both, the last one ends at their end
+template <typename T, typename Compare>
+auto split(std::span<T const> left, std::span<T const> right,
+           std::size_t part, std::size_t parts, Compare &compare)
+    -> std::pair<std::size_t, std::size_t> {
+  auto const i{left.size() * part / parts};
+  if (i == 0) {
+    return {0, 0};
+  }
+  if (i == left.size()) {
+    return {i, right.size()};
+  }
+  auto const j{std::lower_bound(right.begin(), right.end(), left[i], compare)};
+  return {i, static_cast<std::size_t>(j - right.begin())};
+}
+
+// Merges slice `part` of `parts` of `left` and `right` into `out`
+template <typename T, typename Compare>
+auto merge_part(std::span<T const> left, std::span<T const> right,
+                std::span<T> out, std::size_t part, std::size_t parts,
+                Compare &compare) -> void {
+  auto const [left_begin, right_begin]{
+      split(left, right, part, parts, compare)};
+  auto const [left_end, right_end]{
+      split(left, right, part + 1, parts, compare)};
+  std::merge(left.begin() + left_begin, left.begin() + left_end,
+             right.begin() + right_begin, right.begin() + right_end,
+             out.begin() + left_begin + right_begin, compare);
+}
+
+} // namespace detail
+
+template <typename T, typename Compare = std::less<>>
+auto parallel_merge_sort(std::span<T> values, Compare compare = {},
+                         runtime::ThreadPool &pool = runtime::default_pool())
+    -> void {
+  std::size_t runs{pool.size()};
+  if (runs == 1 || values.size() < 2 * runs * 1'024) {
+    std::sort(values.begin(), values.end(), compare);
+    return;
+  }
+
+  // Bounds of the runs, as even splits
+  std::vector<std::size_t> bounds(runs + 1);
+  for (std::size_t run{0}; run <= runs; ++run) {
+    bounds[run] = values.size() * run / runs;
+  }
+  pool.parallel_for(runs, [&](std::size_t run) {
+    std::sort(values.begin() + bounds[run], values.begin() + bounds[run + 1],
+              compare);
+  });
+
+  std::vector<T> buffer(values.begin(), values.end());
+  std::span<T> source{values};
+  std::span<T> destination{buffer};
+  while (runs > 1) {
+    auto const pairs{runs / 2};
+    auto const parts{std::max<std::size_t>(pool.size() / pairs, 1)};
+    pool.parallel_for(pairs * parts, [&](std::size_t task) {
+      auto const pair{task / parts};
+      auto const first{bounds[2 * pair]};
+      auto const middle{bounds[2 * pair + 1]};
+      auto const last{bounds[2 * pair + 2]};
+      std::span<T const> const from{source};
+      detail::merge_part(from.subspan(first, middle - first),
+                         from.subspan(middle, last - middle),
+                         destination.subspan(first, last - first), task % parts,
+                         parts, compare);
+    });
+
+    // An odd run out is copied as is
+    if (runs % 2 == 1) {
+      std::ranges::move(source.subspan(bounds[runs - 1]),
+                        destination.begin() + bounds[runs - 1]);
+    }
+
+    // Bounds of the merged runs
+    std::size_t merged{0};
+    for (std::size_t run{0}; run <= runs; run += 2) {
+      bounds[merged++] = bounds[run];
+    }
+    if (runs % 2 == 1) {
+      bounds[merged++] = bounds[runs];
+    }
+    runs = merged - 1;
+    std::swap(source, destination);
+  }
+
+  if (source.data() != values.data()) {
+    std::ranges::move(source, values.begin());
+  }
+}
+
+} // namespace sorting
+
+#endif
@@ -0,0 +1,130 @@
+#include "../header.h"
+#include "../1_basics/08_operators.h"
+#include "20_sorting.h"
+#include <cstdint>
+#include <random>
+#include <vector>
+#if __has_include(<execution>)
+#include <execution>
+#endif
+
+namespace sorting {
+
+using operators::Vector;
+
+// The order of operator<=>: by x, then by y
+auto lexicographic_key(Vector const &vector) -> std::int64_t {
+  return static_cast<std::int64_t>(vector.x) << 32 |
+         to_unsigned(vector.y);
+}
+
+auto make_vectors(std::size_t count, int range) -> std::vector<Vector> {
+  std::mt19937 generator{42};
+  std::uniform_int_distribution<int> coordinate{-range, range};
+  std::vector<Vector> vectors{};
+  vectors.reserve(count);
+  for (std::size_t i{0}; i < count; ++i) {
+    vectors.emplace_back(coordinate(generator), coordinate(generator));
+  }
+  return vectors;
+}
+
+// ____________________________________________________________________________
+// Sorting
+
+auto sort_vectors() -> void {
+  TRACE_FUNCTION();
+  auto const input{make_vectors(100'000, 1'000)};
+  auto expected{input};
+  std::sort(expected.begin(), expected.end());
+  assert(std::is_sorted(expected.begin(), expected.end()));
+  {
+    auto vectors{input};
+    radix_sort(std::span{vectors}, lexicographic_key);
+    assert(vectors == expected);
+
+    // Stable: sorted by x, the vectors of the same x stay sorted by y
+    radix_sort(std::span{vectors}, [](Vector const &v) { return v.x; });
+    assert(vectors == expected);
+  }
+  {
+    // Odd and even numbers of runs
+    for (unsigned threads : {1, 3, 4}) {
+      runtime::ThreadPool pool{threads};
+      auto vectors{input};
+      parallel_merge_sort(std::span{vectors}, std::less<>{}, pool);
+      assert(vectors == expected);
+    }
+  }
+  {
+    std::vector<unsigned char> bytes{3, 255, 0, 7};
+    radix_sort(std::span{bytes}, [](unsigned char byte) { return byte; });
+    assert((bytes == std::vector<unsigned char>{0, 3, 7, 255}));
+  }
+}
+
+// ____________________________________________________________________________
+// Benchmarks
+// `arg` vectors of random coordinates, sorted lexicographically. The input is
+// restored, untimed, before every iteration
+
+auto bench_sort(runtime::State &state, auto sort) -> void {
+  auto const input{
+      make_vectors(static_cast<std::size_t>(state.arg()), 1'000'000'000)};
+  auto vectors{input};
+  state.set_throughput("Melem", state.arg() / 1e6);
+  for (auto _ : state) {
+    state.pause_timing();
+    std::ranges::copy(input, vectors.begin());
+    state.resume_timing();
+    sort(vectors);
+    runtime::do_not_optimize(vectors.data());
+  }
+}
+
+auto bench_sort_std(runtime::State &state) -> void {
+  bench_sort(state, [](std::vector<Vector> &vectors) {
+    std::sort(vectors.begin(), vectors.end());
+  });
+}
+
+#if defined(__cpp_lib_parallel_algorithm)
+auto bench_sort_std_par(runtime::State &state) -> void {
+  bench_sort(state, [](std::vector<Vector> &vectors) {
+    std::sort(std::execution::par, vectors.begin(), vectors.end());
+  });
+}
+#endif
+
+auto bench_sort_parallel_merge(runtime::State &state) -> void {
+  bench_sort(state, [](std::vector<Vector> &vectors) {
+    parallel_merge_sort(std::span{vectors});
+  });
+}
+
+auto bench_sort_radix(runtime::State &state) -> void {
+  bench_sort(state, [](std::vector<Vector> &vectors) {
+    radix_sort(std::span{vectors}, lexicographic_key);
+  });
+}
+
+// ____________________________________________________________________________
+
+auto run() -> void { sort_vectors(); }
+
+runtime::ModuleRegistrar const registrar{"sorting", run};
+
+runtime::BenchmarkRegistrar const benchmarks[]{
+    {"sorting::std", bench_sort_std,
+     {10'000, 1'000'000, 10'000'000, 100'000'000}},
+#if defined(__cpp_lib_parallel_algorithm)
+    {"sorting::std_par", bench_sort_std_par,
+     {10'000, 1'000'000, 10'000'000, 100'000'000}},
+#endif
+    {"sorting::parallel_merge", bench_sort_parallel_merge,
+     {10'000, 1'000'000, 10'000'000, 100'000'000}},
+    {"sorting::radix", bench_sort_radix,
+     {10'000, 1'000'000, 10'000'000, 100'000'000}},
+};
+
+} // namespace sorting
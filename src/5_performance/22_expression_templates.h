@@ -0,0 +1,227 @@
+#ifndef expression_templates_h
+#define expression_templates_h
+
+#include "26_bounds_check.h"
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <type_traits>
+#include <vector>
+
+namespace expression_templates {
+
+// ____________________________________________________________________________
+// Expression templates
+/*
+Eager operators, as operator+ of operators::Vector, return a new object for
+every operation: over arrays, a + b + c makes a temporary array for a + b,
+then a second one for the result, and reads and writes memory twice.
+
+Here + - * / return a node of an expression tree, which records the
+operation and its operands and computes nothing. The type of a + b + c is
+
+  Binary<std::plus<>, Binary<std::plus<>, Array, Array>, Array>
+
+Indexing a node computes one element, recursively, and assigning a tree to
+an Array evaluates it in a single loop: no temporary arrays, every operand
+read once, and a loop body the compiler can inline and vectorize.
+
+With a checking policy, as bounds_check::Checked, the arrays are checked
+once before the loop, against its last index, each with its own policy;
+the nodes then read them through data(), unchecked: a check per element
+would keep the loop from being vectorized.
+
+Operations are element-wise, so an Array can be assigned an expression of
+itself: a = a + b reads a[i] before writing it.
+
+Arrays are held by reference by the nodes: an expression must not outlive
+its arrays, do not store one with auto beyond the statement that uses it
+*/
+
+template <typename T, bounds_check::Policy Bounds = bounds_check::Default>
+class Array;
+
+template <typename E> inline constexpr bool is_array{false};
+template <typename T, typename Bounds>
+inline constexpr bool is_array<Array<T, Bounds>>{true};
+
+template <typename E> inline constexpr bool is_node{false};
+
+template <typename E>
+concept Expression = is_array<E> || is_node<E>;
+
+// A value used as an operand, the same for every index
+template <typename T> class Scalar {
+public:
+  Scalar(T const &value) : _value{value} {}
+
+  auto operator[](std::size_t) const -> T const & { return _value; }
+
+private:
+  T _value;
+};
+
+template <typename E> inline constexpr bool is_scalar{false};
+template <typename T> inline constexpr bool is_scalar<Scalar<T>>{true};
+
+// Arrays outlive the expression and are held by reference. Nodes and
+// scalars are temporaries, small, and held by value
+template <typename E>
+using Operand = std::conditional_t<is_array<E>, E const &, E>;
+
+// Plain values become scalars
+template <typename E>
+using Node = std::conditional_t<Expression<E>, E, Scalar<E>>;
+
+// An element of an operand, arrays read without their check
+template <typename E> auto element(E const &operand, std::size_t index) {
+  if constexpr (is_array<E>) {
+    return operand.data()[index];
+  } else {
+    return operand[index];
+  }
+}
+
+// Checks that the arrays of an operand have the indices [0, count)
+template <typename E>
+auto check_operand(E const &operand, std::size_t count) -> void {
+  if constexpr (!is_scalar<E>) {
+    operand.check_range(count);
+  }
+}
+
+template <typename Operation, typename Left, typename Right> class Binary {
+public:
+  Binary(Left const &left, Right const &right) : _left{left}, _right{right} {
+    if constexpr (!is_scalar<Left> && !is_scalar<Right>) {
+      assert(left.size() == right.size());
+    }
+  }
+
+  auto size() const -> std::size_t {
+    if constexpr (is_scalar<Left>) {
+      return _right.size();
+    } else {
+      return _left.size();
+    }
+  }
+
+  auto operator[](std::size_t index) const {
+    return Operation{}(element(_left, index), element(_right, index));
+  }
+
+  auto check_range(std::size_t count) const -> void {
+    check_operand(_left, count);
+    check_operand(_right, count);
+  }
+
+private:
+  Operand<Left> _left;
+  Operand<Right> _right;
+};
+
+template <typename Operation, typename Left, typename Right>
+inline constexpr bool is_node<Binary<Operation, Left, Right>>{true};
+
+// ____________________________________________________________________________
+// Array
+
+template <typename T, bounds_check::Policy Bounds> class Array {
+public:
+  using value_type = T;
+
+  explicit Array(std::size_t size, T const &value = T{})
+      : _values(size, value) {}
+
+  Array(std::initializer_list<T> values) : _values{values} {}
+
+  // Evaluates `expression`
+  template <typename E>
+    requires is_node<E>
+  Array(E const &expression) {
+    auto const count{expression.size()};
+    expression.check_range(count);
+    _values.reserve(count);
+    for (std::size_t i{0}; i < count; ++i) {
+      _values.push_back(expression[i]);
+    }
+  }
+
+  // Evaluates `expression` in place, in one loop
+  template <typename E>
+    requires is_node<E>
+  auto operator=(E const &expression) -> Array & {
+    assert(expression.size() == size());
+    auto const count{size()};
+    expression.check_range(count);
+    auto *const values{_values.data()};
+    for (std::size_t i{0}; i < count; ++i) {
+      values[i] = expression[i];
+    }
+    return *this;
+  }
+
+  auto size() const -> std::size_t { return _values.size(); }
+
+  auto operator[](std::size_t index) const -> T const & {
+    Bounds::check(index, size());
+    return _values[index];
+  }
+  auto operator[](std::size_t index) -> T & {
+    Bounds::check(index, size());
+    return _values[index];
+  }
+
+  auto data() const -> T const * { return _values.data(); }
+
+  // Checks the indices [0, count) at once, with the policy
+  auto check_range(std::size_t count) const -> void {
+    if (count > 0) {
+      Bounds::check(count - 1, size());
+    }
+  }
+
+  auto begin() const { return _values.begin(); }
+  auto end() const { return _values.end(); }
+
+private:
+  std::vector<T> _values;
+};
+
+// ____________________________________________________________________________
+// Operators as free-standing functions
+// At least one operand is an array or a node, the other one can be a value
+
+template <typename L, typename R>
+  requires Expression<L> || Expression<R>
+auto operator+(L const &left, R const &right)
+    -> Binary<std::plus<>, Node<L>, Node<R>> {
+  return {left, right};
+}
+
+template <typename L, typename R>
+  requires Expression<L> || Expression<R>
+auto operator-(L const &left, R const &right)
+    -> Binary<std::minus<>, Node<L>, Node<R>> {
+  return {left, right};
+}
+
+template <typename L, typename R>
+  requires Expression<L> || Expression<R>
+auto operator*(L const &left, R const &right)
+    -> Binary<std::multiplies<>, Node<L>, Node<R>> {
+  return {left, right};
+}
+
+template <typename L, typename R>
+  requires Expression<L> || Expression<R>
+auto operator/(L const &left, R const &right)
+    -> Binary<std::divides<>, Node<L>, Node<R>> {
+  return {left, right};
+}
+
+} // namespace expression_templates
+
+#endif
@@ -0,0 +1,438 @@
+#ifndef units_h
+#define units_h
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <compare>
+#include <cstddef>
+#include <numeric>
+#include <ratio>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+namespace units {
+
+// ____________________________________________________________________________
+// Dimensions
+// Exponents of the base dimensions: m^Length * kg^Mass * s^Time
+
+template <int Length, int Mass, int Time> struct Dimension {
+  static constexpr int length{Length};
+  static constexpr int mass{Mass};
+  static constexpr int time{Time};
+};
+
+template <typename D1, typename D2>
+using Multiplied = Dimension<D1::length + D2::length, D1::mass + D2::mass,
+                             D1::time + D2::time>;
+
+template <typename D1, typename D2>
+using Divided = Dimension<D1::length - D2::length, D1::mass - D2::mass,
+                          D1::time - D2::time>;
+
+using Dimensionless = Dimension<0, 0, 0>;
+using Length = Dimension<1, 0, 0>;
+using Mass = Dimension<0, 1, 0>;
+using Time = Dimension<0, 0, 1>;
+using Area = Multiplied<Length, Length>;
+using Velocity = Divided<Length, Time>;
+using Acceleration = Divided<Velocity, Time>;
+using Force = Multiplied<Mass, Acceleration>;
+using Energy = Multiplied<Force, Length>;
+
+// ____________________________________________________________________________
+// Quantities
+/*
+A value of Rep in a unit: the coherent SI unit of dimension D (m, kg, s,
+m/s, kg*m^2/s^2...) multiplied by Scale, a std::ratio. Kilometers are
+Quantity<Length, std::kilo>, hours Quantity<Time, std::ratio<3600>>.
+
+Dimension and scale are types: adding meters to seconds does not compile,
+and conversions between scales are multiplications by a constant known at
+compile time. A Quantity is one Rep, operations on it are the operations
+on Rep: loops over quantities compile to the loops over plain doubles
+*/
+
+template <typename D, typename Scale = std::ratio<1>, typename Rep = double>
+class Quantity {
+public:
+  using dimension = D;
+  using scale = Scale;
+  using rep = Rep;
+
+  constexpr Quantity() = default;
+  explicit constexpr Quantity(Rep value) : _value{value} {}
+
+  // From another scale of the same dimension: km to m multiplies by 1000
+  template <typename OtherScale>
+  constexpr Quantity(Quantity<D, OtherScale, Rep> const &other)
+      : _value{convert<OtherScale>(other.value())} {}
+
+  constexpr auto value() const -> Rep { return _value; }
+
+  constexpr auto operator+=(Quantity const &rhs) -> Quantity & {
+    _value += rhs._value;
+    return *this;
+  }
+  constexpr auto operator-=(Quantity const &rhs) -> Quantity & {
+    _value -= rhs._value;
+    return *this;
+  }
+  constexpr auto operator*=(Rep rhs) -> Quantity & {
+    _value *= rhs;
+    return *this;
+  }
+  constexpr auto operator/=(Rep rhs) -> Quantity & {
+    _value /= rhs;
+    return *this;
+  }
+
+  friend constexpr auto operator+(Quantity lhs, Quantity const &rhs)
+      -> Quantity {
+    return lhs += rhs;
+  }
+  friend constexpr auto operator-(Quantity lhs, Quantity const &rhs)
+      -> Quantity {
+    return lhs -= rhs;
+  }
+  friend constexpr auto operator-(Quantity const &rhs) -> Quantity {
+    return Quantity{-rhs._value};
+  }
+
+  friend constexpr auto operator==(Quantity const &, Quantity const &)
+      -> bool = default;
+  friend constexpr auto operator<=>(Quantity const &, Quantity const &)
+      = default;
+
+private:
+  Rep _value{};
+
+  template <typename OtherScale>
+  static constexpr auto convert(Rep value) -> Rep {
+    using Factor = std::ratio_divide<OtherScale, Scale>;
+    if constexpr (Factor::den == 1) {
+      if constexpr (Factor::num == 1) {
+        return value;
+      } else {
+        return value * static_cast<Rep>(Factor::num);
+      }
+    } else {
+      return value * static_cast<Rep>(Factor::num) /
+             static_cast<Rep>(Factor::den);
+    }
+  }
+};
+
+// ____________________________________________________________________________
+// Arithmetic between dimensions
+// The product of two quantities has the product of their dimensions and of
+// their scales: m * m is m^2, km / h is (5/18) m/s
+
+template <typename D1, typename S1, typename D2, typename S2, typename Rep>
+constexpr auto operator*(Quantity<D1, S1, Rep> const &lhs,
+                         Quantity<D2, S2, Rep> const &rhs)
+    -> Quantity<Multiplied<D1, D2>, std::ratio_multiply<S1, S2>, Rep> {
+  return Quantity<Multiplied<D1, D2>, std::ratio_multiply<S1, S2>, Rep>{
+      lhs.value() * rhs.value()};
+}
+
+template <typename D1, typename S1, typename D2, typename S2, typename Rep>
+constexpr auto operator/(Quantity<D1, S1, Rep> const &lhs,
+                         Quantity<D2, S2, Rep> const &rhs)
+    -> Quantity<Divided<D1, D2>, std::ratio_divide<S1, S2>, Rep> {
+  return Quantity<Divided<D1, D2>, std::ratio_divide<S1, S2>, Rep>{
+      lhs.value() / rhs.value()};
+}
+
+template <typename D, typename S, typename Rep>
+constexpr auto operator*(Rep lhs, Quantity<D, S, Rep> const &rhs)
+    -> Quantity<D, S, Rep> {
+  return Quantity<D, S, Rep>{lhs * rhs.value()};
+}
+
+template <typename D, typename S, typename Rep>
+constexpr auto operator*(Quantity<D, S, Rep> const &lhs, Rep rhs)
+    -> Quantity<D, S, Rep> {
+  return Quantity<D, S, Rep>{lhs.value() * rhs};
+}
+
+template <typename D, typename S, typename Rep>
+constexpr auto operator/(Quantity<D, S, Rep> const &lhs, Rep rhs)
+    -> Quantity<D, S, Rep> {
+  return Quantity<D, S, Rep>{lhs.value() / rhs};
+}
+
+// 1 / s is 1/s
+template <typename D, typename S, typename Rep>
+constexpr auto operator/(Rep lhs, Quantity<D, S, Rep> const &rhs)
+    -> Quantity<Divided<Dimensionless, D>, std::ratio_divide<std::ratio<1>, S>,
+                Rep> {
+  return Quantity<Divided<Dimensionless, D>,
+                  std::ratio_divide<std::ratio<1>, S>, Rep>{lhs / rhs.value()};
+}
+
+// Sum of two scales of a dimension, in the larger scale dividing both:
+// km + m is in m
+template <typename S1, typename S2>
+using CommonScale = typename std::ratio<std::gcd(S1::num, S2::num),
+                                        std::lcm(S1::den, S2::den)>::type;
+
+template <typename D, typename S1, typename S2, typename Rep>
+  requires(!std::is_same_v<S1, S2>)
+constexpr auto operator+(Quantity<D, S1, Rep> const &lhs,
+                         Quantity<D, S2, Rep> const &rhs)
+    -> Quantity<D, CommonScale<S1, S2>, Rep> {
+  using Common = Quantity<D, CommonScale<S1, S2>, Rep>;
+  return Common{lhs} + Common{rhs};
+}
+
+template <typename D, typename S1, typename S2, typename Rep>
+  requires(!std::is_same_v<S1, S2>)
+constexpr auto operator-(Quantity<D, S1, Rep> const &lhs,
+                         Quantity<D, S2, Rep> const &rhs)
+    -> Quantity<D, CommonScale<S1, S2>, Rep> {
+  using Common = Quantity<D, CommonScale<S1, S2>, Rep>;
+  return Common{lhs} - Common{rhs};
+}
+
+// Comparisons between scales, in the common scale: the hidden friends of
+// both operands would convert either one, and be ambiguous
+template <typename D, typename S1, typename S2, typename Rep>
+  requires(!std::is_same_v<S1, S2>)
+constexpr auto operator==(Quantity<D, S1, Rep> const &lhs,
+                          Quantity<D, S2, Rep> const &rhs) -> bool {
+  using Common = Quantity<D, CommonScale<S1, S2>, Rep>;
+  return Common{lhs} == Common{rhs};
+}
+
+template <typename D, typename S1, typename S2, typename Rep>
+  requires(!std::is_same_v<S1, S2>)
+constexpr auto operator<=>(Quantity<D, S1, Rep> const &lhs,
+                           Quantity<D, S2, Rep> const &rhs) {
+  using Common = Quantity<D, CommonScale<S1, S2>, Rep>;
+  return Common{lhs} <=> Common{rhs};
+}
+
+// ____________________________________________________________________________
+// Units
+
+using Meters = Quantity<Length>;
+using Kilometers = Quantity<Length, std::kilo>;
+using Millimeters = Quantity<Length, std::milli>;
+using Kilograms = Quantity<Mass>;
+using Grams = Quantity<Mass, std::milli>;
+using Seconds = Quantity<Time>;
+using Milliseconds = Quantity<Time, std::milli>;
+using Minutes = Quantity<Time, std::ratio<60>>;
+using Hours = Quantity<Time, std::ratio<3'600>>;
+using SquareMeters = Quantity<Area>;
+using MetersPerSecond = Quantity<Velocity>;
+using KilometersPerHour = Quantity<Velocity, std::ratio<5, 18>>;
+using MetersPerSecondSquared = Quantity<Acceleration>;
+using Newtons = Quantity<Force>;
+using Joules = Quantity<Energy>;
+
+namespace literals {
+
+constexpr auto operator""_m(long double value) -> Meters {
+  return Meters{static_cast<double>(value)};
+}
+constexpr auto operator""_m(unsigned long long value) -> Meters {
+  return Meters{static_cast<double>(value)};
+}
+
+constexpr auto operator""_km(long double value) -> Kilometers {
+  return Kilometers{static_cast<double>(value)};
+}
+constexpr auto operator""_km(unsigned long long value) -> Kilometers {
+  return Kilometers{static_cast<double>(value)};
+}
+
+constexpr auto operator""_mm(long double value) -> Millimeters {
+  return Millimeters{static_cast<double>(value)};
+}
+constexpr auto operator""_mm(unsigned long long value) -> Millimeters {
+  return Millimeters{static_cast<double>(value)};
+}
+
+constexpr auto operator""_kg(long double value) -> Kilograms {
+  return Kilograms{static_cast<double>(value)};
+}
+constexpr auto operator""_kg(unsigned long long value) -> Kilograms {
+  return Kilograms{static_cast<double>(value)};
+}
+
+constexpr auto operator""_g(long double value) -> Grams {
+  return Grams{static_cast<double>(value)};
+}
+constexpr auto operator""_g(unsigned long long value) -> Grams {
+  return Grams{static_cast<double>(value)};
+}
+
+constexpr auto operator""_s(long double value) -> Seconds {
+  return Seconds{static_cast<double>(value)};
+}
+constexpr auto operator""_s(unsigned long long value) -> Seconds {
+  return Seconds{static_cast<double>(value)};
+}
+
+constexpr auto operator""_ms(long double value) -> Milliseconds {
+  return Milliseconds{static_cast<double>(value)};
+}
+constexpr auto operator""_ms(unsigned long long value) -> Milliseconds {
+  return Milliseconds{static_cast<double>(value)};
+}
+
+constexpr auto operator""_min(long double value) -> Minutes {
+  return Minutes{static_cast<double>(value)};
+}
+constexpr auto operator""_min(unsigned long long value) -> Minutes {
+  return Minutes{static_cast<double>(value)};
+}
+
+constexpr auto operator""_h(long double value) -> Hours {
+  return Hours{static_cast<double>(value)};
+}
+constexpr auto operator""_h(unsigned long long value) -> Hours {
+  return Hours{static_cast<double>(value)};
+}
+
+} // namespace literals
+
+// ____________________________________________________________________________
+// Symbols
+// Built at compile time: a prefix for the scale, then the base units with
+// their exponents, "km", "kg*m/s^2". Some units have their own name
+
+struct Symbol {
+  std::array<char, 32> characters{};
+  std::size_t size{};
+
+  constexpr Symbol() = default;
+  constexpr Symbol(std::string_view text) { append(text); }
+
+  constexpr auto append(std::string_view text) -> void {
+    for (auto const character : text) {
+      characters[size++] = character;
+    }
+  }
+
+  constexpr auto append(long number) -> void {
+    if (number >= 10) {
+      append(number / 10);
+    }
+    characters[size++] = static_cast<char>('0' + number % 10);
+  }
+
+  constexpr auto view() const -> std::string_view {
+    return {characters.data(), size};
+  }
+};
+
+// Letter of the usual prefixes, empty for the other scales
+template <typename Scale> constexpr auto prefix_letter() -> std::string_view {
+  if constexpr (std::ratio_equal_v<Scale, std::mega>) {
+    return "M";
+  } else if constexpr (std::ratio_equal_v<Scale, std::kilo>) {
+    return "k";
+  } else if constexpr (std::ratio_equal_v<Scale, std::centi>) {
+    return "c";
+  } else if constexpr (std::ratio_equal_v<Scale, std::milli>) {
+    return "m";
+  } else if constexpr (std::ratio_equal_v<Scale, std::micro>) {
+    return "u";
+  } else {
+    return "";
+  }
+}
+
+// A letter, or the ratio in parentheses. The base unit of mass, kg, has a
+// prefix already: the scales of units with a mass are always ratios
+template <typename Scale>
+constexpr auto prefix(Symbol &symbol, bool letters) -> void {
+  if constexpr (!std::ratio_equal_v<Scale, std::ratio<1>>) {
+    if (letters && !prefix_letter<Scale>().empty()) {
+      symbol.append(prefix_letter<Scale>());
+      return;
+    }
+    symbol.append("(");
+    symbol.append(static_cast<long>(Scale::num));
+    if constexpr (Scale::den != 1) {
+      symbol.append("/");
+      symbol.append(static_cast<long>(Scale::den));
+    }
+    symbol.append(")");
+  }
+}
+
+template <typename D, typename Scale> constexpr auto make_symbol() -> Symbol {
+  Symbol symbol{};
+  prefix<Scale>(symbol, D::mass == 0);
+
+  constexpr std::pair<std::string_view, int> bases[]{
+      {"kg", D::mass}, {"m", D::length}, {"s", D::time}};
+  auto const append{[&](std::string_view base, int exponent) {
+    symbol.append(base);
+    if (exponent > 1) {
+      symbol.append("^");
+      symbol.append(static_cast<long>(exponent));
+    }
+  }};
+
+  auto numerator{false};
+  for (auto const &[base, exponent] : bases) {
+    if (exponent > 0) {
+      if (numerator) {
+        symbol.append("*");
+      }
+      append(base, exponent);
+      numerator = true;
+    }
+  }
+  for (auto const &[base, exponent] : bases) {
+    if (exponent < 0) {
+      symbol.append(numerator ? "/" : "1/");
+      append(base, -exponent);
+      numerator = true;
+    }
+  }
+  return symbol;
+}
+
+template <typename D, typename Scale>
+inline constexpr Symbol unit_symbol{make_symbol<D, Scale>()};
+
+template <> inline constexpr Symbol unit_symbol<Mass, std::milli>{"g"};
+template <> inline constexpr Symbol unit_symbol<Time, std::ratio<60>>{"min"};
+template <> inline constexpr Symbol unit_symbol<Time, std::ratio<3'600>>{"h"};
+template <>
+inline constexpr Symbol unit_symbol<Velocity, std::ratio<5, 18>>{"km/h"};
+template <> inline constexpr Symbol unit_symbol<Force, std::ratio<1>>{"N"};
+template <> inline constexpr Symbol unit_symbol<Energy, std::ratio<1>>{"J"};
+
+// ____________________________________________________________________________
+// Formatting
+// "<value> <symbol>" into [first, last), as std::to_chars: no allocation,
+// the end of the characters written, or std::errc::value_too_large
+
+template <typename D, typename S, typename Rep>
+auto to_chars(char *first, char *last, Quantity<D, S, Rep> const &quantity)
+    -> std::to_chars_result {
+  auto const result{std::to_chars(first, last, quantity.value())};
+  constexpr auto text{unit_symbol<D, S>.view()};
+  if (result.ec != std::errc{} || text.empty()) {
+    return result;
+  }
+  if (last - result.ptr < static_cast<std::ptrdiff_t>(text.size() + 1)) {
+    return {last, std::errc::value_too_large};
+  }
+  *result.ptr = ' ';
+  return {std::ranges::copy(text, result.ptr + 1).out, std::errc{}};
+}
+
+} // namespace units
+
+#endif
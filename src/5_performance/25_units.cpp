@@ -0,0 +1,221 @@
+#include "../header.h"
+#include "24_units.h"
+#include <array>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace units {
+
+using namespace literals;
+
+// No overhead in space: one double, copied as a double
+static_assert(sizeof(Meters) == sizeof(double));
+static_assert(sizeof(Joules) == sizeof(double));
+static_assert(std::is_trivially_copyable_v<Meters>);
+static_assert(std::is_standard_layout_v<Meters>);
+
+template <typename L, typename R>
+concept Addable = requires(L lhs, R rhs) { lhs + rhs; };
+
+// ____________________________________________________________________________
+// Dimensional analysis
+
+auto dimensional_analysis() -> void {
+  TRACE_FUNCTION();
+  // Evaluated at compile time
+  constexpr auto distance{1_km + 500_m};
+  static_assert(std::same_as<decltype(distance), Meters const>);
+  static_assert(distance == 1'500_m);
+
+  constexpr auto speed{distance / 100_s};
+  static_assert(std::same_as<decltype(speed), MetersPerSecond const>);
+  static_assert(KilometersPerHour{speed} == KilometersPerHour{54});
+
+  constexpr auto force{2_kg * (speed / 3_s)};
+  static_assert(force == Newtons{10});
+  static_assert(force * 2_m == Joules{20});
+  static_assert(Minutes{1_h} == 60_min && Seconds{1_min} == 60_s);
+  static_assert(1_km == 1'000_m && 1_km > 500_m && 1_h != 59_min);
+
+  // Quantities of different dimensions do not add up
+  static_assert(Addable<Meters, Kilometers>);
+  static_assert(!Addable<Meters, Seconds>);
+  static_assert(!Addable<Meters, double>);
+
+  // At run time too
+  std::vector<Meters> const legs{1.5_km, 700_m, 300'000_mm};
+  Meters total{};
+  for (auto const leg : legs) {
+    total += leg;
+  }
+  assert(total == 2'500_m);
+  assert(total / 2.0 < 1'500_m);
+}
+
+// ____________________________________________________________________________
+// Formatting
+
+template <typename Q> auto format(Q const &quantity) -> std::string_view {
+  static std::array<char, 48> buffer{};
+  auto const [end, error]{
+      to_chars(buffer.data(), buffer.data() + buffer.size(), quantity)};
+  assert(error == std::errc{});
+  return {buffer.data(), end};
+}
+
+auto formatting() -> void {
+  TRACE_FUNCTION();
+  assert(format(1.5_km) == "1.5 km");
+  assert(format(250_g) == "250 g");
+  assert(format(2_kg) == "2 kg");
+  assert(format(36_km / 1_h) == "36 km/h");
+  assert(format(9.81_m / (1_s * 1_s)) == "9.81 m/s^2");
+  assert(format(3_m * 4_m) == "12 m^2");
+  assert(format(Quantity<Force, std::kilo>{2}) == "2 (1000)kg*m/s^2");
+  assert(format(1_kg * 1_m * 1_m / (1_s * 1_s)) == "1 J");
+  assert(format(2.0 / 1_s) == "2 1/s");
+  assert(format(1_m / 4_m) == "0.25");
+
+  // Nothing written past the buffer
+  std::array<char, 3> small{};
+  auto const result{to_chars(small.data(), small.data() + small.size(), 1_km)};
+  assert(result.ec == std::errc::value_too_large);
+}
+
+// ____________________________________________________________________________
+// Benchmarks
+// The same kernels on doubles and on quantities: moving points at constant
+// speed, and the total kinetic energy. The kernels are functions of their
+// own, the instructions of the two versions can be compared with
+// objdump -d -C. Formatting as the Meter of operators, std::to_string plus
+// the symbol, against to_chars
+
+[[gnu::noinline]] auto move_raw(std::span<double> positions,
+                                std::span<double const> speeds,
+                                double elapsed) -> void {
+  for (std::size_t i{0}; i < positions.size(); ++i) {
+    positions[i] += speeds[i] * elapsed;
+  }
+}
+
+[[gnu::noinline]] auto move_units(std::span<Meters> positions,
+                                  std::span<MetersPerSecond const> speeds,
+                                  Seconds elapsed) -> void {
+  for (std::size_t i{0}; i < positions.size(); ++i) {
+    positions[i] += speeds[i] * elapsed;
+  }
+}
+
+[[gnu::noinline]] auto kinetic_energy_raw(std::span<double const> masses,
+                                          std::span<double const> speeds)
+    -> double {
+  double total{0};
+  for (std::size_t i{0}; i < masses.size(); ++i) {
+    total += 0.5 * masses[i] * speeds[i] * speeds[i];
+  }
+  return total;
+}
+
+[[gnu::noinline]] auto
+kinetic_energy_units(std::span<Kilograms const> masses,
+                     std::span<MetersPerSecond const> speeds) -> Joules {
+  Joules total{};
+  for (std::size_t i{0}; i < masses.size(); ++i) {
+    total += 0.5 * masses[i] * speeds[i] * speeds[i];
+  }
+  return total;
+}
+
+template <typename T> auto make_values(long count) -> std::vector<T> {
+  std::vector<T> values{};
+  values.reserve(static_cast<std::size_t>(count));
+  for (long i{0}; i < count; ++i) {
+    values.emplace_back(static_cast<double>(i % 1'000) / 10);
+  }
+  return values;
+}
+
+auto bench_move_raw(runtime::State &state) -> void {
+  auto positions{make_values<double>(state.arg())};
+  auto const speeds{make_values<double>(state.arg())};
+  state.set_throughput("Melem", state.arg() / 1e6);
+  for (auto _ : state) {
+    move_raw(positions, speeds, 0.001);
+    runtime::do_not_optimize(positions.data());
+  }
+}
+
+auto bench_move_units(runtime::State &state) -> void {
+  auto positions{make_values<Meters>(state.arg())};
+  auto const speeds{make_values<MetersPerSecond>(state.arg())};
+  state.set_throughput("Melem", state.arg() / 1e6);
+  for (auto _ : state) {
+    move_units(positions, speeds, 1_ms);
+    runtime::do_not_optimize(positions.data());
+  }
+}
+
+auto bench_kinetic_energy_raw(runtime::State &state) -> void {
+  auto const masses{make_values<double>(state.arg())};
+  auto const speeds{make_values<double>(state.arg())};
+  state.set_throughput("Melem", state.arg() / 1e6);
+  for (auto _ : state) {
+    runtime::do_not_optimize(kinetic_energy_raw(masses, speeds));
+  }
+}
+
+auto bench_kinetic_energy_units(runtime::State &state) -> void {
+  auto const masses{make_values<Kilograms>(state.arg())};
+  auto const speeds{make_values<MetersPerSecond>(state.arg())};
+  state.set_throughput("Melem", state.arg() / 1e6);
+  for (auto _ : state) {
+    runtime::do_not_optimize(kinetic_energy_units(masses, speeds));
+  }
+}
+
+auto bench_format_string(runtime::State &state) -> void {
+  auto const distances{make_values<Meters>(state.arg())};
+  state.set_throughput("Melem", state.arg() / 1e6);
+  for (auto _ : state) {
+    for (auto const distance : distances) {
+      auto const text{std::to_string(distance.value()) + " m"};
+      runtime::do_not_optimize(text);
+    }
+  }
+}
+
+auto bench_format_to_chars(runtime::State &state) -> void {
+  auto const distances{make_values<Meters>(state.arg())};
+  std::array<char, 48> buffer{};
+  state.set_throughput("Melem", state.arg() / 1e6);
+  for (auto _ : state) {
+    for (auto const distance : distances) {
+      auto const result{
+          to_chars(buffer.data(), buffer.data() + buffer.size(), distance)};
+      runtime::do_not_optimize(result.ptr);
+    }
+  }
+}
+
+// ____________________________________________________________________________
+
+auto run() -> void {
+  dimensional_analysis();
+  formatting();
+}
+
+runtime::ModuleRegistrar const registrar{"units", run};
+
+runtime::BenchmarkRegistrar const benchmarks[]{
+    {"units::move_raw", bench_move_raw, {1'000, 1'000'000}},
+    {"units::move_units", bench_move_units, {1'000, 1'000'000}},
+    {"units::kinetic_energy_raw", bench_kinetic_energy_raw,
+     {1'000, 1'000'000}},
+    {"units::kinetic_energy_units", bench_kinetic_energy_units,
+     {1'000, 1'000'000}},
+    {"units::format_string", bench_format_string, {1'000}},
+    {"units::format_to_chars", bench_format_to_chars, {1'000}},
+};
+
+} // namespace units
@@ -0,0 +1,62 @@
+#ifndef bounds_check_h
+#define bounds_check_h
+
+#include <cassert>
+#include <cstddef>
+
+namespace bounds_check {
+
+// ____________________________________________________________________________
+// Bounds-checking policies
+/*
+How operator[] of a container checks its index, chosen at compile time by
+a template parameter:
+- Unchecked: no check, an index out of range is undefined behavior
+- Asserted: assert, no check in builds with NDEBUG
+- Checked: always, throws std::out_of_range
+
+The check is one comparison of unsigned values: a negative index converted
+to std::size_t is larger than any size. The throw is in a function out of
+line and cold: the caller keeps a compare and a branch never taken, which
+the branch predictor learns, and no exception code in the loop.
+
+Default is the policy of the containers of the project: Asserted, or
+Checked when built with ABOUT_CPP_CHECKED_INDEXING
+*/
+
+// Throws std::out_of_range
+[[noreturn, gnu::cold]] auto out_of_range(std::size_t index, std::size_t size)
+    -> void;
+
+struct Unchecked {
+  static constexpr auto check(std::size_t, std::size_t) -> void {}
+};
+
+struct Asserted {
+  static constexpr auto check(std::size_t index, std::size_t size) -> void {
+    assert(index < size);
+  }
+};
+
+struct Checked {
+  static constexpr auto check(std::size_t index, std::size_t size) -> void {
+    if (index >= size) [[unlikely]] {
+      out_of_range(index, size);
+    }
+  }
+};
+
+template <typename P>
+concept Policy = requires(std::size_t index, std::size_t size) {
+  P::check(index, size);
+};
+
+#if ABOUT_CPP_CHECKED_INDEXING
+using Default = Checked;
+#else
+using Default = Asserted;
+#endif
+
+} // namespace bounds_check
+
+#endif
@@ -0,0 +1,149 @@
+#include "../header.h"
+#include "../1_basics/08_operators.h"
+#include "16_soa_vector.h"
+#include "22_expression_templates.h"
+#include "26_bounds_check.h"
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace bounds_check {
+
+auto out_of_range(std::size_t index, std::size_t size) -> void {
+  throw std::out_of_range{"index " + std::to_string(index) +
+                          " out of range for size " + std::to_string(size)};
+}
+
+template <typename Container>
+auto throws_out_of_range(Container &container, std::size_t index) -> bool {
+  try {
+    static_cast<void>(container[index]);
+  } catch (std::out_of_range const &) {
+    return true;
+  }
+  return false;
+}
+
+// ____________________________________________________________________________
+// Policies
+
+auto policies() -> void {
+  TRACE_FUNCTION();
+  {
+    expression_templates::Array<int, Checked> array{1, 2, 3};
+    assert(array[2] == 3);
+    assert(throws_out_of_range(array, 3));
+
+    // A negative index, converted, is a large one
+    assert(throws_out_of_range(array, static_cast<std::size_t>(-1)));
+
+    auto thrown{false};
+    try {
+      static_cast<void>(array[5]);
+    } catch (std::out_of_range const &error) {
+      thrown = true;
+      assert(std::string{error.what()} == "index 5 out of range for size 3");
+    }
+    assert(thrown);
+
+    // Expressions check each array once, before the loop
+    expression_templates::Array<int, Checked> const sum{array + array * 2};
+    assert(sum[2] == 9);
+  }
+  {
+    soa_vector::SoaVector<operators::Vector, Checked> vectors{};
+    vectors.push_back({3, 1});
+    assert(!throws_out_of_range(vectors, 0));
+    assert(throws_out_of_range(vectors, 1));
+  }
+  {
+    operators::Vector vector{3, 1};
+    assert(vector[1] == 1);
+    assert(throws_out_of_range(vector, -1));
+    assert(throws_out_of_range(vector, 2));
+  }
+  {
+    // Unchecked costs nothing and checks nothing
+    expression_templates::Array<int, Unchecked> const array{1, 2, 3};
+    assert(array[0] == 1);
+  }
+}
+
+// ____________________________________________________________________________
+// Benchmarks
+// Loops indexing an expression_templates::Array of ints with each policy:
+// - a sum in order: the condition of the loop, i < size(), already proves
+//   the check. With GCC 12 at -O3, sum_checked and sum_unchecked compile to
+//   the same vectorized loop, without a call to out_of_range (objdump -d):
+//   their times differ by the noise of the machine only, which on a shared
+//   core is larger than the differences between the policies, either way
+// - a sum through random indices: the check stays, one comparison and one
+//   branch per element
+// With NDEBUG, as in the benchmark builds, Asserted is Unchecked
+
+template <typename Bounds>
+auto make_array(long count) -> expression_templates::Array<int, Bounds> {
+  expression_templates::Array<int, Bounds> array(
+      static_cast<std::size_t>(count));
+  for (std::size_t i{0}; i < array.size(); ++i) {
+    array[i] = static_cast<int>(i % 1'000);
+  }
+  return array;
+}
+
+auto make_indices(long count) -> std::vector<std::size_t> {
+  std::mt19937 generator{42};
+  std::uniform_int_distribution<std::size_t> index{
+      0, static_cast<std::size_t>(count) - 1};
+  std::vector<std::size_t> indices(static_cast<std::size_t>(count));
+  for (auto &i : indices) {
+    i = index(generator);
+  }
+  return indices;
+}
+
+template <typename Bounds> auto bench_sum(runtime::State &state) -> void {
+  auto const array{make_array<Bounds>(state.arg())};
+  state.set_throughput("Melem", state.arg() / 1e6);
+  for (auto _ : state) {
+    long total{0};
+    for (std::size_t i{0}; i < array.size(); ++i) {
+      total += array[i];
+    }
+    runtime::do_not_optimize(total);
+  }
+}
+
+template <typename Bounds> auto bench_gather(runtime::State &state) -> void {
+  auto const array{make_array<Bounds>(state.arg())};
+  auto const indices{make_indices(state.arg())};
+  state.set_throughput("Melem", state.arg() / 1e6);
+  for (auto _ : state) {
+    long total{0};
+    for (auto const index : indices) {
+      total += array[index];
+    }
+    runtime::do_not_optimize(total);
+  }
+}
+
+// ____________________________________________________________________________
+
+auto run() -> void { policies(); }
+
+runtime::ModuleRegistrar const registrar{"bounds_check", run};
+
+runtime::BenchmarkRegistrar const benchmarks[]{
+    {"bounds_check::sum_unchecked", bench_sum<Unchecked>, {1'000, 1'000'000}},
+    {"bounds_check::sum_asserted", bench_sum<Asserted>, {1'000, 1'000'000}},
+    {"bounds_check::sum_checked", bench_sum<Checked>, {1'000, 1'000'000}},
+    {"bounds_check::gather_unchecked", bench_gather<Unchecked>,
+     {1'000, 1'000'000}},
+    {"bounds_check::gather_asserted", bench_gather<Asserted>,
+     {1'000, 1'000'000}},
+    {"bounds_check::gather_checked", bench_gather<Checked>,
+     {1'000, 1'000'000}},
+};
+
+} // namespace bounds_check
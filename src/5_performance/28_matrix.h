@@ -0,0 +1,273 @@
+#ifndef matrix_h
+#define matrix_h
+
+#include "../runtime/thread_pool.h"
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <vector>
+
+namespace matrix {
+
+// ____________________________________________________________________________
+// Matrix
+/*
+A dense rows x columns matrix in one std::vector, in row-major (the rows one
+after the other) or column-major order. Elements are accessed with the call
+operator, m(row, column), a member function as operator[] of
+operators::Vector: before C++23 operator[] takes a single index. Arithmetic
+is free-standing, as for operators::Vector
+*/
+
+enum class Layout { row_major, column_major };
+
+template <typename T, Layout L = Layout::row_major> class Matrix {
+public:
+  using value_type = T;
+  static constexpr Layout layout{L};
+
+  Matrix(std::size_t rows, std::size_t columns, T const &value = T{})
+      : _rows{rows}, _columns{columns}, _elements(rows * columns, value) {}
+
+  // Rows of elements, whatever the layout
+  Matrix(std::initializer_list<std::initializer_list<T>> rows)
+      : Matrix(rows.size(), rows.size() == 0 ? 0 : rows.begin()->size()) {
+    std::size_t row{0};
+    for (auto const &elements : rows) {
+      assert(elements.size() == _columns);
+      std::size_t column{0};
+      for (auto const &element : elements) {
+        (*this)(row, column++) = element;
+      }
+      ++row;
+    }
+  }
+
+  auto rows() const -> std::size_t { return _rows; }
+  auto columns() const -> std::size_t { return _columns; }
+
+  // Distance between the elements of consecutive rows and columns
+  auto row_stride() const -> std::size_t {
+    return L == Layout::row_major ? _columns : 1;
+  }
+  auto column_stride() const -> std::size_t {
+    return L == Layout::row_major ? 1 : _rows;
+  }
+
+  auto operator()(std::size_t row, std::size_t column) const -> T const & {
+    return _elements[row * row_stride() + column * column_stride()];
+  }
+  auto operator()(std::size_t row, std::size_t column) -> T & {
+    return _elements[row * row_stride() + column * column_stride()];
+  }
+
+  auto data() const -> T const * { return _elements.data(); }
+  auto data() -> T * { return _elements.data(); }
+
+private:
+  std::size_t _rows;
+  std::size_t _columns;
+  std::vector<T> _elements;
+};
+
+// ____________________________________________________________________________
+// Operators as free-standing functions
+
+template <typename T, Layout L1, Layout L2>
+auto operator==(Matrix<T, L1> const &lhs, Matrix<T, L2> const &rhs) -> bool {
+  if (lhs.rows() != rhs.rows() || lhs.columns() != rhs.columns()) {
+    return false;
+  }
+  for (std::size_t row{0}; row < lhs.rows(); ++row) {
+    for (std::size_t column{0}; column < lhs.columns(); ++column) {
+      if (lhs(row, column) != rhs(row, column)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+template <typename T, Layout L>
+auto operator+=(Matrix<T, L> &lhs, Matrix<T, L> const &rhs) -> Matrix<T, L> & {
+  assert(lhs.rows() == rhs.rows() && lhs.columns() == rhs.columns());
+  auto const count{lhs.rows() * lhs.columns()};
+  for (std::size_t i{0}; i < count; ++i) {
+    lhs.data()[i] += rhs.data()[i];
+  }
+  return lhs;
+}
+
+template <typename T, Layout L>
+auto operator+(Matrix<T, L> const &lhs, Matrix<T, L> const &rhs)
+    -> Matrix<T, L> {
+  auto matrix{lhs};
+  matrix += rhs;
+  return matrix;
+}
+
+// ____________________________________________________________________________
+// Multiplication
+/*
+The three nested loops of the definition, c(i, j) += a(i, k) * b(k, j),
+read a column of b for every element of c: past a few hundred elements, b
+no longer fits in the caches and every multiply-add waits for memory.
+
+multiply() follows the structure of BLIS and OpenBLAS:
+- cache blocking: c is computed by blocks of kc columns of a (the rows of
+  b). The block of b, kc x nc, is copied (packed) to stay in the last level
+  cache, a block of mc rows of a to stay in the L2 cache
+- register tiling: a micro-kernel computes a tile of mr x nr elements of c
+  in local variables, from a sliver of a (mr x kc) and one of b (kc x nr)
+  both packed contiguous, in the order the kernel reads them. It loads
+  mr + nr values for mr * nr multiply-adds
+- the inner loop of the kernel is over the nr columns, a constant: the
+  compiler unrolls it and vectorizes it, the accumulators stay in registers
+- the blocks of rows of a are independent: they are computed in parallel
+  on a runtime::ThreadPool, each thread packing its block of a
+
+Packing also reads the matrices through their layout once, the kernel
+always sees the same packed order: a, b and c can have any layout
+*/
+
+template <typename T> struct Blocking {
+  // Two SSE registers of T per row of the tile, 8 registers of accumulators
+  static constexpr std::size_t nr{32 / sizeof(T)};
+  static constexpr std::size_t mr{4};
+  static constexpr std::size_t kc{256};
+  static constexpr std::size_t mc{96};
+  static constexpr std::size_t nc{2'048};
+};
+
+namespace detail {
+
+// c(i, j) += sum over k of a[k * mr + i] * b[k * nr + j], for the first
+// `rows` x `columns` elements of the tile
+template <typename T>
+auto micro_kernel(std::size_t kc, T const *a, T const *b, T *c,
+                  std::size_t row_stride, std::size_t column_stride,
+                  std::size_t rows, std::size_t columns) -> void {
+  constexpr auto mr{Blocking<T>::mr};
+  constexpr auto nr{Blocking<T>::nr};
+  T accumulators[mr][nr]{};
+  for (std::size_t k{0}; k < kc; ++k) {
+    for (std::size_t i{0}; i < mr; ++i) {
+      for (std::size_t j{0}; j < nr; ++j) {
+        accumulators[i][j] += a[k * mr + i] * b[k * nr + j];
+      }
+    }
+  }
+  for (std::size_t i{0}; i < rows; ++i) {
+    for (std::size_t j{0}; j < columns; ++j) {
+      c[i * row_stride + j * column_stride] += accumulators[i][j];
+    }
+  }
+}
+
+// Slivers of mr rows of a(rows, depth), padded with zeros
+template <typename T, Layout L>
+auto pack_a(Matrix<T, L> const &a, std::size_t row, std::size_t rows,
+            std::size_t depth, std::size_t kc, T *packed) -> void {
+  constexpr auto mr{Blocking<T>::mr};
+  for (std::size_t sliver{0}; sliver < rows; sliver += mr) {
+    for (std::size_t k{0}; k < kc; ++k) {
+      for (std::size_t i{0}; i < mr; ++i) {
+        *packed++ = sliver + i < rows ? a(row + sliver + i, depth + k) : T{};
+      }
+    }
+  }
+}
+
+// Slivers of nr columns of b(depth, column), padded with zeros
+template <typename T, Layout L>
+auto pack_b(Matrix<T, L> const &b, std::size_t depth, std::size_t kc,
+            std::size_t column, std::size_t columns, T *packed) -> void {
+  constexpr auto nr{Blocking<T>::nr};
+  for (std::size_t sliver{0}; sliver < columns; sliver += nr) {
+    for (std::size_t k{0}; k < kc; ++k) {
+      for (std::size_t j{0}; j < nr; ++j) {
+        *packed++ =
+            sliver + j < columns ? b(depth + k, column + sliver + j) : T{};
+      }
+    }
+  }
+}
+
+constexpr auto round_up(std::size_t value, std::size_t multiple)
+    -> std::size_t {
+  return (value + multiple - 1) / multiple * multiple;
+}
+
+} // namespace detail
+
+// c = a * b
+template <typename T, Layout LA, Layout LB, Layout LC>
+auto multiply(Matrix<T, LA> const &a, Matrix<T, LB> const &b,
+              Matrix<T, LC> &c,
+              runtime::ThreadPool &pool = runtime::default_pool()) -> void {
+  using B = Blocking<T>;
+  assert(a.columns() == b.rows());
+  assert(c.rows() == a.rows() && c.columns() == b.columns());
+  auto const m{a.rows()};
+  auto const n{b.columns()};
+  auto const depth{a.columns()};
+  std::fill(c.data(), c.data() + m * n, T{});
+
+  std::vector<T> packed_b(std::min(B::kc, depth) *
+                          detail::round_up(std::min(B::nc, n), B::nr));
+  auto const row_blocks{(m + B::mc - 1) / B::mc};
+  for (std::size_t jc{0}; jc < n; jc += B::nc) {
+    auto const nb{std::min(B::nc, n - jc)};
+    for (std::size_t pc{0}; pc < depth; pc += B::kc) {
+      auto const kb{std::min(B::kc, depth - pc)};
+      detail::pack_b(b, pc, kb, jc, nb, packed_b.data());
+
+      pool.parallel_for(row_blocks, [&](std::size_t block) {
+        thread_local std::vector<T> packed_a{};
+        packed_a.resize(B::kc * detail::round_up(B::mc, B::mr));
+        auto const ic{block * B::mc};
+        auto const mb{std::min(B::mc, m - ic)};
+        detail::pack_a(a, ic, mb, pc, kb, packed_a.data());
+
+        for (std::size_t jr{0}; jr < nb; jr += B::nr) {
+          for (std::size_t ir{0}; ir < mb; ir += B::mr) {
+            detail::micro_kernel(
+                kb, packed_a.data() + ir * kb, packed_b.data() + jr * kb,
+                &c(ic + ir, jc + jr), c.row_stride(), c.column_stride(),
+                std::min(B::mr, mb - ir), std::min(B::nr, nb - jr));
+          }
+        }
+      });
+    }
+  }
+}
+
+// c = a * b, the three loops of the definition
+template <typename T, Layout LA, Layout LB, Layout LC>
+auto multiply_naive(Matrix<T, LA> const &a, Matrix<T, LB> const &b,
+                    Matrix<T, LC> &c) -> void {
+  assert(a.columns() == b.rows());
+  assert(c.rows() == a.rows() && c.columns() == b.columns());
+  for (std::size_t i{0}; i < a.rows(); ++i) {
+    for (std::size_t j{0}; j < b.columns(); ++j) {
+      T sum{};
+      for (std::size_t k{0}; k < a.columns(); ++k) {
+        sum += a(i, k) * b(k, j);
+      }
+      c(i, j) = sum;
+    }
+  }
+}
+
+template <typename T, Layout LA, Layout LB>
+auto operator*(Matrix<T, LA> const &lhs, Matrix<T, LB> const &rhs)
+    -> Matrix<T, LA> {
+  Matrix<T, LA> result(lhs.rows(), rhs.columns());
+  multiply(lhs, rhs, result);
+  return result;
+}
+
+} // namespace matrix
+
+#endif
@@ -0,0 +1,106 @@
+#include "../header.h"
+#include "28_matrix.h"
+#include <random>
+
+namespace matrix {
+
+template <typename T, Layout L = Layout::row_major>
+auto make_matrix(std::size_t rows, std::size_t columns) -> Matrix<T, L> {
+  std::mt19937 generator{42};
+  std::uniform_int_distribution<int> element{-8, 8};
+  Matrix<T, L> matrix(rows, columns);
+  for (std::size_t row{0}; row < rows; ++row) {
+    for (std::size_t column{0}; column < columns; ++column) {
+      matrix(row, column) = static_cast<T>(element(generator));
+    }
+  }
+  return matrix;
+}
+
+// ____________________________________________________________________________
+// Operators
+
+auto free_operators() -> void {
+  TRACE_FUNCTION();
+  Matrix<int> const a{{1, 2, 3}, {4, 5, 6}};
+  Matrix<int, Layout::column_major> const b{{1, 0}, {0, 1}, {1, 1}};
+  assert(a(1, 2) == 6 && b(2, 0) == 1);
+  assert(a.data()[1] == 2 && b.data()[1] == 0);
+
+  assert(a * b == (Matrix<int>{{4, 5}, {10, 11}}));
+  assert(a + a == (Matrix<int>{{2, 4, 6}, {8, 10, 12}}));
+}
+
+// ____________________________________________________________________________
+// Multiplication
+
+auto multiplication() -> void {
+  TRACE_FUNCTION();
+  // Sizes that are not multiples of the blocks and of the tiles; small
+  // integers, products exact in double
+  auto const a{make_matrix<double>(100, 270)};
+  auto const b{make_matrix<double, Layout::column_major>(270, 2'100)};
+  Matrix<double> expected(100, 2'100);
+  multiply_naive(a, b, expected);
+
+  for (unsigned threads : {1, 3}) {
+    runtime::ThreadPool pool{threads};
+    Matrix<double, Layout::column_major> c(100, 2'100);
+    multiply(a, b, c, pool);
+    assert(c == expected);
+  }
+
+  auto const af{make_matrix<float>(5, 7)};
+  auto const bf{make_matrix<float>(7, 3)};
+  Matrix<float> cf(5, 3);
+  multiply_naive(af, bf, cf);
+  assert(af * bf == cf);
+}
+
+// ____________________________________________________________________________
+// Benchmarks
+// Square matrices of `arg` x `arg` elements, 2 * arg^3 floating-point
+// operations. The naive loops stop at 1024, at 4096 they take minutes
+
+template <typename T> auto bench_naive(runtime::State &state) -> void {
+  auto const n{static_cast<std::size_t>(state.arg())};
+  auto const a{make_matrix<T>(n, n)};
+  auto const b{make_matrix<T>(n, n)};
+  Matrix<T> c(n, n);
+  state.set_throughput("GFLOP", 2.0 * n * n * n / 1e9);
+  for (auto _ : state) {
+    multiply_naive(a, b, c);
+    runtime::do_not_optimize(c.data());
+  }
+}
+
+template <typename T> auto bench_blocked(runtime::State &state) -> void {
+  auto const n{static_cast<std::size_t>(state.arg())};
+  auto const a{make_matrix<T>(n, n)};
+  auto const b{make_matrix<T>(n, n)};
+  Matrix<T> c(n, n);
+  state.set_throughput("GFLOP", 2.0 * n * n * n / 1e9);
+  for (auto _ : state) {
+    multiply(a, b, c);
+    runtime::do_not_optimize(c.data());
+  }
+}
+
+// ____________________________________________________________________________
+
+auto run() -> void {
+  free_operators();
+  multiplication();
+}
+
+runtime::ModuleRegistrar const registrar{"matrix", run};
+
+runtime::BenchmarkRegistrar const benchmarks[]{
+    {"matrix::naive_float", bench_naive<float>, {64, 256, 1'024}},
+    {"matrix::naive_double", bench_naive<double>, {64, 256, 1'024}},
+    {"matrix::blocked_float", bench_blocked<float>, {64, 256, 1'024, 4'096}},
+    {"matrix::blocked_double", bench_blocked<double>,
+     {64, 256, 1'024, 4'096}},
+};
+
+} // namespace matrix
@@ -0,0 +1,460 @@
+#ifndef fft_h
+#define fft_h
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <initializer_list>
+#include <numbers>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace fft {
+
+// ____________________________________________________________________________
+// Split storage
+/*
+An array of std::complex<T> interleaves the parts: re, im, re, im... A
+SIMD register loaded from it holds real and imaginary parts mixed, and a
+complex multiplication must shuffle them. A SplitArray keeps the real parts
+in one array and the imaginary parts in another: element-wise arithmetic
+is arithmetic on arrays of T, which the compiler vectorizes as is.
+
+The product of std::complex follows Annex G of C: a NaN result is checked
+for and recomputed by a library call (__muldc3), a branch in every
+multiplication that also keeps loops from being vectorized
+*/
+
+template <typename T> class SplitArray {
+public:
+  using value_type = std::complex<T>;
+
+  explicit SplitArray(std::size_t size, std::complex<T> const &value = {})
+      : _real(size, value.real()), _imag(size, value.imag()) {}
+
+  SplitArray(std::initializer_list<std::complex<T>> values)
+      : SplitArray(values.size()) {
+    std::size_t index{0};
+    for (auto const &value : values) {
+      set(index++, value);
+    }
+  }
+
+  auto size() const -> std::size_t { return _real.size(); }
+
+  // A copy of the element: there is no std::complex<T> to refer to
+  auto operator[](std::size_t index) const -> std::complex<T> {
+    return {_real[index], _imag[index]};
+  }
+  auto set(std::size_t index, std::complex<T> const &value) -> void {
+    _real[index] = value.real();
+    _imag[index] = value.imag();
+  }
+
+  auto real() const -> std::span<T const> { return _real; }
+  auto real() -> std::span<T> { return _real; }
+  auto imag() const -> std::span<T const> { return _imag; }
+  auto imag() -> std::span<T> { return _imag; }
+
+private:
+  std::vector<T> _real;
+  std::vector<T> _imag;
+};
+
+template <typename T>
+auto operator==(SplitArray<T> const &lhs, SplitArray<T> const &rhs) -> bool {
+  return std::ranges::equal(lhs.real(), rhs.real()) &&
+         std::ranges::equal(lhs.imag(), rhs.imag());
+}
+
+// ____________________________________________________________________________
+// Multiply-accumulate
+// c[i] += a[i] * b[i], the inner step of convolutions and correlations in
+// the frequency domain
+
+template <typename T>
+auto multiply_accumulate(SplitArray<T> const &a, SplitArray<T> const &b,
+                         SplitArray<T> &c) -> void {
+  assert(a.size() == b.size() && a.size() == c.size());
+  auto const count{c.size()};
+  auto const *const ar{a.real().data()};
+  auto const *const ai{a.imag().data()};
+  auto const *const br{b.real().data()};
+  auto const *const bi{b.imag().data()};
+  auto *const cr{c.real().data()};
+  auto *const ci{c.imag().data()};
+  for (std::size_t i{0}; i < count; ++i) {
+    cr[i] += ar[i] * br[i] - ai[i] * bi[i];
+    ci[i] += ar[i] * bi[i] + ai[i] * br[i];
+  }
+}
+
+template <typename T>
+auto multiply_accumulate(std::span<std::complex<T> const> a,
+                         std::span<std::complex<T> const> b,
+                         std::span<std::complex<T>> c) -> void {
+  assert(a.size() == b.size() && a.size() == c.size());
+  for (std::size_t i{0}; i < c.size(); ++i) {
+    c[i] += a[i] * b[i];
+  }
+}
+
+// ____________________________________________________________________________
+// Discrete Fourier transform
+/*
+X[k] = sum over j of x[j] * w^(j * k), w = exp(-2 pi i / n): n
+multiplications for each of the n outputs. Exact in its definition, used
+as the reference of the FFT
+*/
+
+template <typename T>
+auto dft(std::span<std::complex<T> const> in, std::span<std::complex<T>> out)
+    -> void {
+  assert(in.size() == out.size() && in.data() != out.data());
+  auto const n{in.size()};
+  // w^(j * k) = w^(j * k mod n)
+  std::vector<std::complex<T>> roots(n);
+  for (std::size_t j{0}; j < n; ++j) {
+    roots[j] = std::polar(T{1}, static_cast<T>(-2 * std::numbers::pi * j / n));
+  }
+  for (std::size_t k{0}; k < n; ++k) {
+    std::complex<T> sum{};
+    std::size_t power{0};
+    for (std::size_t j{0}; j < n; ++j) {
+      sum += in[j] * roots[power];
+      power += k;
+      power -= power >= n ? n : 0;
+    }
+    out[k] = sum;
+  }
+}
+
+// ____________________________________________________________________________
+// Fast Fourier transform
+/*
+For n = p * m, the DFT of length n is computed from the p DFTs of length m
+of the elements j = q (mod p), combined by n / p butterflies of p inputs
+multiplied by the twiddle factors w^(q * k). Applied to every factor of n,
+it takes O(n * (p1 + p2 + ...)) operations: O(n log n) for a power of two.
+
+Plan follows the Stockham formulation: every stage reads one buffer and
+writes the other, in order, without the bit-reversal permutation of the
+Cooley-Tukey algorithm in place. With r the index of the subsequence and k
+of the frequency, a stage of radix p reads x[r + q * m + p * m * k] and
+writes X[r + m * k + m * l * u]: the loop over r is contiguous in both and
+vectorized, the twiddle factors, precomputed for each stage, are constant
+in it. In the last stages, where r takes few values, the loops are
+swapped.
+
+- sizes: factors 4, then 2, have butterflies written out, other factors
+  (3, 5, 7...) a generic butterfly in O(p^2): a prime size is a DFT
+- storage: SplitArray, or std::complex<T> interleaved, the same code on a
+  View of stride 1 or 2. Split, a radix-4 stage reads and writes 16
+  streams, twice as many, at distances that for large powers of two map
+  to the same cache sets: there interleaved storage is faster
+- in place: `in` and `out` can be the same array. Out of place, `in` is
+  read by the first stage only; in place with an odd number of stages, it
+  is first copied to the work buffer
+- inverse: conj(fft(conj(x))) / n, with x + iy swapped to y + ix instead
+  of conjugated, an exchange of pointers
+
+A Plan holds a work buffer: one Plan per thread
+*/
+
+namespace detail {
+
+// The real and imaginary parts of element i at real[i * Stride] and
+// imag[i * Stride]
+template <typename T, std::size_t Stride> struct View {
+  T *real;
+  T *imag;
+
+  auto re(std::size_t index) const -> T & { return real[index * Stride]; }
+  auto im(std::size_t index) const -> T & { return imag[index * Stride]; }
+
+  auto swapped() const -> View { return {imag, real}; }
+};
+
+// Radix 2 and 4: the butterflies of a stage from DFTs of length l to DFTs
+// of length l * P, for one k along r or for one r along k. The butterfly
+// (k, r) reads inputs r + q * m + P * m * k and twiddle factors
+// (q - 1) * l + k, for 0 <= q < P, and writes outputs r + m * k + m * l * u,
+// for 0 <= u < P.
+// A stage never writes the buffer it reads: __restrict tells the compiler,
+// which otherwise checks at run time the overlap of every pair of the 16
+// streams of a radix-4 butterfly, gives up past 10 and does not vectorize
+template <std::size_t P, std::size_t Stride, bool AlongK, typename T>
+auto butterflies(T const *__restrict in_re, T const *__restrict in_im,
+                 T *__restrict out_re, T *__restrict out_im,
+                 T const *__restrict twiddle_re,
+                 T const *__restrict twiddle_im, std::size_t m, std::size_t l,
+                 std::size_t fixed) -> void {
+  auto const count{AlongK ? l : m};
+  for (std::size_t i{0}; i < count; ++i) {
+    auto const k{AlongK ? i : fixed};
+    auto const r{AlongK ? fixed : i};
+    T re[P];
+    T im[P];
+    for (std::size_t q{0}; q < P; ++q) {
+      auto const index{(r + q * m + P * m * k) * Stride};
+      re[q] = in_re[index];
+      im[q] = in_im[index];
+    }
+    for (std::size_t q{1}; q < P; ++q) {
+      auto const wr{twiddle_re[(q - 1) * l + k]};
+      auto const wi{twiddle_im[(q - 1) * l + k]};
+      auto const x{re[q]};
+      re[q] = x * wr - im[q] * wi;
+      im[q] = x * wi + im[q] * wr;
+    }
+    auto const stride{m * l * Stride};
+    auto const index{(r + m * k) * Stride};
+    if constexpr (P == 2) {
+      out_re[index] = re[0] + re[1];
+      out_im[index] = im[0] + im[1];
+      out_re[index + stride] = re[0] - re[1];
+      out_im[index + stride] = im[0] - im[1];
+    } else {
+      // w^(n / 4) = -i
+      auto const sum02_re{re[0] + re[2]};
+      auto const sum02_im{im[0] + im[2]};
+      auto const diff02_re{re[0] - re[2]};
+      auto const diff02_im{im[0] - im[2]};
+      auto const sum13_re{re[1] + re[3]};
+      auto const sum13_im{im[1] + im[3]};
+      auto const diff13_re{re[1] - re[3]};
+      auto const diff13_im{im[1] - im[3]};
+      out_re[index] = sum02_re + sum13_re;
+      out_im[index] = sum02_im + sum13_im;
+      out_re[index + stride] = diff02_re + diff13_im;
+      out_im[index + stride] = diff02_im - diff13_re;
+      out_re[index + 2 * stride] = sum02_re - sum13_re;
+      out_im[index + 2 * stride] = sum02_im - sum13_im;
+      out_re[index + 3 * stride] = diff02_re - diff13_im;
+      out_im[index + 3 * stride] = diff02_im + diff13_re;
+    }
+  }
+}
+
+// The inner loop is along the longer of r and k
+template <std::size_t P, std::size_t Stride, typename T>
+auto radix_stage(View<T const, Stride> in, View<T, Stride> out, std::size_t n,
+                 std::size_t l, T const *twiddle_re, T const *twiddle_im)
+    -> void {
+  static_assert(P == 2 || P == 4);
+  auto const m{n / (l * P)};
+  if (m >= l) {
+    for (std::size_t k{0}; k < l; ++k) {
+      butterflies<P, Stride, false>(in.real, in.imag, out.real, out.imag,
+                                    twiddle_re, twiddle_im, m, l, k);
+    }
+  } else {
+    for (std::size_t r{0}; r < m; ++r) {
+      butterflies<P, Stride, true>(in.real, in.imag, out.real, out.imag,
+                                   twiddle_re, twiddle_im, m, l, r);
+    }
+  }
+}
+
+// Any radix p, with roots[j] = w_p^j and `scratch` of 2 * p elements
+template <typename T, typename In, typename Out>
+auto generic_stage(In in, Out out, std::size_t n, std::size_t l,
+                   std::size_t p, T const *twiddle_re, T const *twiddle_im,
+                   T const *root_re, T const *root_im, T *scratch) -> void {
+  auto const m{n / (l * p)};
+  auto *const re{scratch};
+  auto *const im{scratch + p};
+  for (std::size_t k{0}; k < l; ++k) {
+    for (std::size_t r{0}; r < m; ++r) {
+      re[0] = in.re(r + p * m * k);
+      im[0] = in.im(r + p * m * k);
+      for (std::size_t q{1}; q < p; ++q) {
+        auto const index{r + q * m + p * m * k};
+        auto const wr{twiddle_re[(q - 1) * l + k]};
+        auto const wi{twiddle_im[(q - 1) * l + k]};
+        re[q] = in.re(index) * wr - in.im(index) * wi;
+        im[q] = in.re(index) * wi + in.im(index) * wr;
+      }
+      for (std::size_t u{0}; u < p; ++u) {
+        T sum_re{0};
+        T sum_im{0};
+        std::size_t power{0};
+        for (std::size_t q{0}; q < p; ++q) {
+          sum_re += re[q] * root_re[power] - im[q] * root_im[power];
+          sum_im += re[q] * root_im[power] + im[q] * root_re[power];
+          power += u;
+          power -= power >= p ? p : 0;
+        }
+        out.re(r + m * k + m * l * u) = sum_re;
+        out.im(r + m * k + m * l * u) = sum_im;
+      }
+    }
+  }
+}
+
+} // namespace detail
+
+template <typename T> class Plan {
+public:
+  explicit Plan(std::size_t size) : _size{size}, _work(2 * size) {
+    std::size_t l{1};
+    std::size_t remaining{size};
+    std::size_t largest{0};
+    while (remaining > 1) {
+      std::size_t radix{3};
+      if (remaining % 4 == 0) {
+        radix = 4;
+      } else if (remaining % 2 == 0) {
+        radix = 2;
+      }
+      while (remaining % radix != 0) {
+        radix += 2;
+      }
+      _stages.push_back(make_stage(l, radix));
+      largest = std::max(largest, radix);
+      l *= radix;
+      remaining /= radix;
+    }
+    _scratch.resize(2 * largest);
+  }
+
+  auto size() const -> std::size_t { return _size; }
+
+  // The radices of the stages, in order
+  auto radices() const -> std::vector<std::size_t> {
+    std::vector<std::size_t> radices{};
+    for (auto const &stage : _stages) {
+      radices.push_back(stage.radix);
+    }
+    return radices;
+  }
+
+  auto forward(SplitArray<T> const &in, SplitArray<T> &out) -> void {
+    execute(split(in), split(out));
+  }
+  auto inverse(SplitArray<T> const &in, SplitArray<T> &out) -> void {
+    execute(split(in).swapped(), split(out).swapped());
+    scale(out.real());
+    scale(out.imag());
+  }
+
+  auto forward(std::span<std::complex<T> const> in,
+               std::span<std::complex<T>> out) -> void {
+    execute(interleaved(in), interleaved(out));
+  }
+  auto inverse(std::span<std::complex<T> const> in,
+               std::span<std::complex<T>> out) -> void {
+    execute(interleaved(in).swapped(), interleaved(out).swapped());
+    // std::complex<T> is an array of two T
+    scale({reinterpret_cast<T *>(out.data()), 2 * out.size()});
+  }
+
+private:
+  struct Stage {
+    std::size_t radix;
+    // The length of the DFTs the stage combines
+    std::size_t length;
+    // w^(q * k) for 1 <= q < radix and k < length, at (q - 1) * length + k
+    std::vector<T> twiddle_re;
+    std::vector<T> twiddle_im;
+    // w_radix^j, for the generic butterfly
+    std::vector<T> root_re;
+    std::vector<T> root_im;
+  };
+
+  static auto make_stage(std::size_t l, std::size_t radix) -> Stage {
+    Stage stage{radix, l, {}, {}, {}, {}};
+    auto const angle{-2 * std::numbers::pi / static_cast<double>(l * radix)};
+    for (std::size_t q{1}; q < radix; ++q) {
+      for (std::size_t k{0}; k < l; ++k) {
+        auto const theta{angle * static_cast<double>(q * k)};
+        stage.twiddle_re.push_back(static_cast<T>(std::cos(theta)));
+        stage.twiddle_im.push_back(static_cast<T>(std::sin(theta)));
+      }
+    }
+    if (radix != 2 && radix != 4) {
+      for (std::size_t j{0}; j < radix; ++j) {
+        auto const theta{-2 * std::numbers::pi * static_cast<double>(j) /
+                         static_cast<double>(radix)};
+        stage.root_re.push_back(static_cast<T>(std::cos(theta)));
+        stage.root_im.push_back(static_cast<T>(std::sin(theta)));
+      }
+    }
+    return stage;
+  }
+
+  static auto split(SplitArray<T> const &array) -> detail::View<T const, 1> {
+    return {array.real().data(), array.imag().data()};
+  }
+  static auto split(SplitArray<T> &array) -> detail::View<T, 1> {
+    return {array.real().data(), array.imag().data()};
+  }
+  template <typename C> static auto interleaved(std::span<C> array) {
+    using Part = std::conditional_t<std::is_const_v<C>, T const, T>;
+    auto *const parts{reinterpret_cast<Part *>(array.data())};
+    return detail::View<Part, 2>{parts, parts + 1};
+  }
+
+  auto scale(std::span<T> values) const -> void {
+    auto const factor{T{1} / static_cast<T>(_size)};
+    for (auto &value : values) {
+      value *= factor;
+    }
+  }
+
+  template <std::size_t Stride>
+  auto execute(detail::View<T const, Stride> in, detail::View<T, Stride> out)
+      -> void {
+    auto *const buffer{_work.data()};
+    detail::View<T, Stride> const work{
+        buffer, Stride == 1 ? buffer + _size : buffer + 1};
+    auto const count{_stages.size()};
+    // The last stage writes to `out`, the others alternate with `work`
+    auto const destination{[&](std::size_t stage) {
+      return (count - stage) % 2 == 1 ? out : work;
+    }};
+    detail::View<T const, Stride> source{in};
+    if (count == 0 || (in.real == out.real && count % 2 == 1)) {
+      auto const copy{count == 0 ? out : work};
+      for (std::size_t i{0}; i < _size; ++i) {
+        copy.re(i) = in.re(i);
+        copy.im(i) = in.im(i);
+      }
+      source = {copy.real, copy.imag};
+    }
+    for (std::size_t i{0}; i < count; ++i) {
+      auto const &stage{_stages[i]};
+      auto const target{destination(i)};
+      switch (stage.radix) {
+      case 2:
+        detail::radix_stage<2>(source, target, _size, stage.length,
+                               stage.twiddle_re.data(),
+                               stage.twiddle_im.data());
+        break;
+      case 4:
+        detail::radix_stage<4>(source, target, _size, stage.length,
+                               stage.twiddle_re.data(),
+                               stage.twiddle_im.data());
+        break;
+      default:
+        detail::generic_stage(source, target, _size, stage.length,
+                              stage.radix, stage.twiddle_re.data(),
+                              stage.twiddle_im.data(), stage.root_re.data(),
+                              stage.root_im.data(), _scratch.data());
+      }
+      source = {target.real, target.imag};
+    }
+  }
+
+  std::size_t _size;
+  std::vector<Stage> _stages{};
+  std::vector<T> _work;
+  std::vector<T> _scratch{};
+};
+
+} // namespace fft
+
+#endif
@@ -0,0 +1,208 @@
+#include "../header.h"
+#include "30_fft.h"
+#include <cmath>
+#include <complex>
+#include <random>
+#include <span>
+#include <vector>
+
+namespace fft {
+
+using namespace std::complex_literals;
+
+template <typename T>
+auto make_signal(std::size_t size) -> std::vector<std::complex<T>> {
+  std::mt19937 generator{42};
+  std::uniform_real_distribution<T> part{-1, 1};
+  std::vector<std::complex<T>> signal(size);
+  for (auto &value : signal) {
+    value = {part(generator), part(generator)};
+  }
+  return signal;
+}
+
+template <typename T>
+auto to_split(std::span<std::complex<T> const> values) -> SplitArray<T> {
+  SplitArray<T> array(values.size());
+  for (std::size_t i{0}; i < values.size(); ++i) {
+    array.set(i, values[i]);
+  }
+  return array;
+}
+
+template <typename T, typename Array>
+auto max_error(std::span<std::complex<T> const> expected, Array const &actual)
+    -> T {
+  T error{0};
+  for (std::size_t i{0}; i < expected.size(); ++i) {
+    error = std::max(error, std::abs(expected[i] - actual[i]));
+  }
+  return error;
+}
+
+// ____________________________________________________________________________
+// Split storage
+
+auto split_storage() -> void {
+  TRACE_FUNCTION();
+  SplitArray<double> a{2.0 + 1i, 1i};
+  assert(a[0] == 2.0 + 1i && a.real()[1] == 0 && a.imag()[1] == 1);
+
+  SplitArray<double> c{1.0 + 0i, 0i};
+  multiply_accumulate(a, a, c);
+  assert(c == (SplitArray<double>{4.0 + 4i, -1.0 + 0i}));
+
+  std::vector<std::complex<double>> const b{2.0 + 1i, 1i};
+  std::vector<std::complex<double>> d{1.0 + 0i, 0i};
+  multiply_accumulate(std::span{b}, std::span{b}, std::span{d});
+  assert(d[0] == c[0] && d[1] == c[1]);
+}
+
+// ____________________________________________________________________________
+// Transforms
+
+template <typename T> auto check_transforms(std::size_t size, T tolerance) {
+  auto const signal{make_signal<T>(size)};
+  std::vector<std::complex<T>> expected(size);
+  dft<T>(signal, expected);
+
+  Plan<T> plan{size};
+  // Out of place and in place, split and interleaved
+  auto const input{to_split<T>(signal)};
+  SplitArray<T> output(size);
+  plan.forward(input, output);
+  assert(max_error<T>(expected, output) < tolerance);
+
+  auto data{input};
+  plan.forward(data, data);
+  assert(data == output);
+
+  std::vector<std::complex<T>> interleaved(size);
+  plan.forward(signal, interleaved);
+  assert(max_error<T>(expected, interleaved) < tolerance);
+
+  plan.inverse(interleaved, interleaved);
+  assert(max_error<T>(signal, interleaved) < tolerance);
+  plan.inverse(output, data);
+  assert(max_error<T>(signal, data) < tolerance);
+}
+
+auto transforms() -> void {
+  TRACE_FUNCTION();
+  {
+    // The transform of an impulse is constant, of a constant an impulse
+    Plan<double> plan{8};
+    assert((plan.radices() == std::vector<std::size_t>{4, 2}));
+    SplitArray<double> x(8);
+    x.set(0, 1);
+    plan.forward(x, x);
+    assert(x == SplitArray<double>(8, 1.0 + 0i));
+    plan.forward(x, x);
+    assert(x[0] == 8.0 + 0i && std::abs(x[1]) < 1e-12);
+  }
+  {
+    Plan<double> const plan{1'000};
+    assert((plan.radices() == std::vector<std::size_t>{4, 2, 5, 5, 5}));
+  }
+
+  // Powers of two, mixed sizes, primes
+  for (std::size_t size : {1, 2, 4, 8, 64, 1'024, 6, 12, 60, 1'000, 97}) {
+    check_transforms<double>(size, 1e-9);
+  }
+  check_transforms<float>(1'024, 1e-3f);
+  check_transforms<float>(360, 1e-3f);
+}
+
+// ____________________________________________________________________________
+// Benchmarks
+// Double precision. Transforms report 5 * n * log2(n) / time, the usual
+// measure of FFTs: operations of the radix-2 algorithm, not the ones done.
+// The DFT is measured the same way, to compare times
+
+auto fft_operations(long size) -> double {
+  return 5.0 * static_cast<double>(size) *
+         std::log2(static_cast<double>(size)) / 1e9;
+}
+
+auto bench_dft(runtime::State &state) -> void {
+  auto const size{static_cast<std::size_t>(state.arg())};
+  auto const signal{make_signal<double>(size)};
+  std::vector<std::complex<double>> spectrum(size);
+  state.set_throughput("GFLOP", fft_operations(state.arg()));
+  for (auto _ : state) {
+    dft<double>(signal, spectrum);
+    runtime::do_not_optimize(spectrum.data());
+  }
+}
+
+auto bench_fft_split(runtime::State &state) -> void {
+  auto const size{static_cast<std::size_t>(state.arg())};
+  auto const signal{make_signal<double>(size)};
+  auto const input{to_split<double>(signal)};
+  SplitArray<double> spectrum(size);
+  Plan<double> plan{size};
+  state.set_throughput("GFLOP", fft_operations(state.arg()));
+  for (auto _ : state) {
+    plan.forward(input, spectrum);
+    runtime::do_not_optimize(spectrum.real().data());
+  }
+}
+
+auto bench_fft_interleaved(runtime::State &state) -> void {
+  auto const size{static_cast<std::size_t>(state.arg())};
+  auto const signal{make_signal<double>(size)};
+  std::vector<std::complex<double>> spectrum(size);
+  Plan<double> plan{size};
+  state.set_throughput("GFLOP", fft_operations(state.arg()));
+  for (auto _ : state) {
+    plan.forward(signal, spectrum);
+    runtime::do_not_optimize(spectrum.data());
+  }
+}
+
+auto bench_mac_split(runtime::State &state) -> void {
+  auto const size{static_cast<std::size_t>(state.arg())};
+  auto const a{to_split<double>(make_signal<double>(size))};
+  auto const b{to_split<double>(make_signal<double>(size))};
+  SplitArray<double> c(size);
+  state.set_throughput("Melem", state.arg() / 1e6);
+  for (auto _ : state) {
+    multiply_accumulate(a, b, c);
+    runtime::do_not_optimize(c.real().data());
+  }
+}
+
+auto bench_mac_interleaved(runtime::State &state) -> void {
+  auto const size{static_cast<std::size_t>(state.arg())};
+  auto const a{make_signal<double>(size)};
+  auto const b{make_signal<double>(size)};
+  std::vector<std::complex<double>> c(size);
+  state.set_throughput("Melem", state.arg() / 1e6);
+  for (auto _ : state) {
+    multiply_accumulate(std::span{a}, std::span{b}, std::span{c});
+    runtime::do_not_optimize(c.data());
+  }
+}
+
+// ____________________________________________________________________________
+
+auto run() -> void {
+  split_storage();
+  transforms();
+}
+
+runtime::ModuleRegistrar const registrar{"fft", run};
+
+runtime::BenchmarkRegistrar const benchmarks[]{
+    {"fft::dft", bench_dft, {256, 1'024, 4'096}},
+    {"fft::fft_split",
+     bench_fft_split,
+     {1'024, 1'000, 65'536, 60'000, 1'048'576, 1'000'000}},
+    {"fft::fft_interleaved",
+     bench_fft_interleaved,
+     {1'024, 1'000, 65'536, 60'000, 1'048'576, 1'000'000}},
+    {"fft::mac_split", bench_mac_split, {1'000, 1'000'000}},
+    {"fft::mac_interleaved", bench_mac_interleaved, {1'000, 1'000'000}},
+};
+
+} // namespace fft
@@ -0,0 +1,145 @@
+#include "../header.h"
+#include "../1_basics/08_operators.h"
+#include "32_parallel_algorithms.h"
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+namespace parallel_algorithms {
+
+auto make_values(std::size_t count) -> std::vector<int> {
+  std::vector<int> values(count);
+  std::iota(values.begin(), values.end(), 0);
+  return values;
+}
+
+// ____________________________________________________________________________
+// Transform and for_each
+
+auto transform() -> void {
+  TRACE_FUNCTION();
+  runtime::ThreadPool pool{3};
+  auto values{make_values(100'000)};
+
+  // In place, in chunks of at least 1'000 elements
+  parallel_transform(values, values.begin(), operators::Incrementer{2}, pool,
+                     1'000);
+  assert(values.front() == 2 && values.back() == 100'001);
+
+  // A mutable lambda: a non-const call operator, called through a copy
+  std::vector<long> results(values.size());
+  parallel_transform(values, results.begin(),
+                     [](int x) mutable -> long { return x - 2; }, pool, 1'000);
+  assert(std::ranges::equal(results, make_values(100'000)));
+}
+
+auto for_each() -> void {
+  TRACE_FUNCTION();
+  runtime::ThreadPool pool{3};
+  auto values{make_values(100'000)};
+  parallel_for_each(values, [](int &x) { x *= 2; }, pool, 1'000);
+  assert(values[50'000] == 100'000);
+
+  // The first exception of a chunk is rethrown on the calling thread
+  try {
+    parallel_for_each(
+        values,
+        [](int x) {
+          if (x == 20'000) {
+            throw std::runtime_error{"20'000"};
+          }
+        },
+        pool, 1'000);
+    assert(false);
+  } catch (std::runtime_error const &) {
+  }
+}
+
+auto chunks() -> void {
+  TRACE_FUNCTION();
+  runtime::ThreadPool pool{4};
+  // Less than two chunks of `grain` elements: serial
+  assert(detail::chunk_count(1'000, 1'000, pool) == 1);
+  assert(detail::chunk_count(default_grain, default_grain, pool) == 1);
+  assert(detail::chunk_count(2 * default_grain, default_grain, pool) == 2);
+  // At most 4 per thread
+  assert(detail::chunk_count(100'000'000, default_grain, pool) == 16);
+  // A single thread: serial, at any size
+  runtime::ThreadPool single{1};
+  assert(detail::chunk_count(100'000'000, default_grain, single) == 1);
+}
+
+// ____________________________________________________________________________
+// Benchmarks
+// operators::Incrementer over ints, in place:
+// - serial: std::ranges::transform
+// - threads_N: a pool of N threads, chunks of 1'024 elements at least, to
+//   show the cost of the parallel loop at every size. threads_1 runs
+//   serially, as the chunks of a single thread would not overlap
+// - automatic: the default pool and grain, serial below the crossover
+// On a single core, the threads take turns: the pools of more than one
+// thread measure the cost of waking the workers, not a speedup
+
+auto bench_serial(runtime::State &state) -> void {
+  auto values{make_values(static_cast<std::size_t>(state.arg()))};
+  state.set_throughput("Melem", state.arg() / 1e6);
+  for (auto _ : state) {
+    std::ranges::transform(values, values.begin(), operators::Incrementer{1});
+    runtime::do_not_optimize(values.data());
+  }
+}
+
+template <unsigned Threads>
+auto bench_threads(runtime::State &state) -> void {
+  runtime::ThreadPool pool{Threads};
+  auto values{make_values(static_cast<std::size_t>(state.arg()))};
+  state.set_throughput("Melem", state.arg() / 1e6);
+  for (auto _ : state) {
+    parallel_transform(values, values.begin(), operators::Incrementer{1},
+                       pool, 1'024);
+    runtime::do_not_optimize(values.data());
+  }
+}
+
+auto bench_automatic(runtime::State &state) -> void {
+  auto values{make_values(static_cast<std::size_t>(state.arg()))};
+  state.set_throughput("Melem", state.arg() / 1e6);
+  for (auto _ : state) {
+    parallel_transform(values, values.begin(), operators::Incrementer{1});
+    runtime::do_not_optimize(values.data());
+  }
+}
+
+// ____________________________________________________________________________
+
+auto run() -> void {
+  transform();
+  for_each();
+  chunks();
+}
+
+runtime::ModuleRegistrar const registrar{"parallel_algorithms", run};
+
+runtime::BenchmarkRegistrar const benchmarks[]{
+    {"parallel_algorithms::serial",
+     bench_serial,
+     {1'000, 10'000, 100'000, 1'000'000, 10'000'000}},
+    {"parallel_algorithms::threads_1",
+     bench_threads<1>,
+     {1'000, 10'000, 100'000, 1'000'000, 10'000'000}},
+    {"parallel_algorithms::threads_2",
+     bench_threads<2>,
+     {1'000, 10'000, 100'000, 1'000'000, 10'000'000}},
+    {"parallel_algorithms::threads_4",
+     bench_threads<4>,
+     {1'000, 10'000, 100'000, 1'000'000, 10'000'000}},
+    {"parallel_algorithms::threads_8",
+     bench_threads<8>,
+     {1'000, 10'000, 100'000, 1'000'000, 10'000'000}},
+    {"parallel_algorithms::automatic",
+     bench_automatic,
+     {1'000, 10'000, 100'000, 1'000'000, 10'000'000}},
+};
+
+} // namespace parallel_algorithms
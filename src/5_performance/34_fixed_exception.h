@@ -0,0 +1,114 @@
+#ifndef fixed_exception_h
+#define fixed_exception_h
+
+#include <algorithm>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <exception>
+#include <string_view>
+
+namespace fixed_exception {
+
+// ____________________________________________________________________________
+// Exceptions without heap allocations
+/*
+An exception holding a std::string, as exceptions::CustomException, pays
+for the string at every throw: its allocation, and the ones of the
+temporary strings a message is built from. They are a part of the cost:
+the unwinding takes a microsecond or more, an error returned as a value
+nanoseconds. For an error path taken at high rates, a value is the fix.
+
+- StaticError: a message known at compile time, only its address is
+  stored. The constructor takes a Message, whose consteval constructor
+  accepts constant expressions only: a pointer to a buffer that can go
+  away does not compile
+- FormattedError: a message built at the throw point from strings and
+  numbers, written with std::to_chars in a buffer inside the exception,
+  truncated to Capacity - 1 characters
+
+Both derive from std::exception and are meant as bases:
+
+  struct OutOfRange : FormattedError<64> {
+    using FormattedError::FormattedError;
+  };
+
+The exception object itself is still allocated by the C++ runtime
+(__cxa_allocate_exception), with an emergency pool when the heap is
+exhausted: the allocations of a throw are one, whatever the message
+*/
+
+// A string known at compile time
+class Message {
+public:
+  consteval Message(char const *text) : _text{text} {}
+
+  auto text() const -> char const * { return _text; }
+
+private:
+  char const *_text;
+};
+
+class StaticError : public std::exception {
+public:
+  explicit StaticError(Message message) noexcept : _message{message.text()} {}
+
+  auto what() const noexcept -> char const * override { return _message; }
+
+private:
+  char const *_message;
+};
+
+template <typename T>
+concept Number = (std::integral<T> && !std::same_as<T, bool> &&
+                  !std::same_as<T, char>) ||
+                 std::floating_point<T>;
+
+template <std::size_t Capacity = 128>
+class FormattedError : public std::exception {
+  static_assert(Capacity > 0);
+
+public:
+  // The parts, strings, characters and numbers, one after the other
+  template <typename... Parts>
+  explicit FormattedError(Parts const &...parts) noexcept {
+    (append(parts), ...);
+    _buffer[_size] = '\0';
+  }
+
+  auto what() const noexcept -> char const * override { return _buffer; }
+
+  auto size() const noexcept -> std::size_t { return _size; }
+
+private:
+  char _buffer[Capacity];
+  std::size_t _size{0};
+
+  // The room left, one character kept for the terminating null
+  auto available() const noexcept -> std::size_t {
+    return Capacity - 1 - _size;
+  }
+
+  auto append(std::string_view text) noexcept -> void {
+    auto const count{std::min(text.size(), available())};
+    std::copy_n(text.data(), count, _buffer + _size);
+    _size += count;
+  }
+
+  auto append(char character) noexcept -> void {
+    append(std::string_view{&character, 1});
+  }
+
+  // A number that does not fit is left out
+  template <Number T> auto append(T value) noexcept -> void {
+    auto *const first{_buffer + _size};
+    auto const [last, error]{std::to_chars(first, first + available(), value)};
+    if (error == std::errc{}) {
+      _size += static_cast<std::size_t>(last - first);
+    }
+  }
+};
+
+} // namespace fixed_exception
+
+#endif
@@ -0,0 +1,189 @@
+#include "../header.h"
+#include "../runtime/allocations.h"
+#include "34_fixed_exception.h"
+#include <string>
+#include <utility>
+
+namespace fixed_exception {
+
+// As exceptions::CustomException
+class StringError : public std::exception {
+public:
+  explicit StringError(std::string message) : _message{std::move(message)} {}
+
+  auto what() const noexcept -> char const * override {
+    return _message.c_str();
+  }
+
+private:
+  std::string _message;
+};
+
+struct OutOfRange : FormattedError<64> {
+  using FormattedError::FormattedError;
+};
+
+// ____________________________________________________________________________
+// Messages
+
+auto messages() -> void {
+  TRACE_FUNCTION();
+  try {
+    throw StaticError{"static error"};
+  } catch (std::exception const &error) {
+    assert(std::string{error.what()} == "static error");
+  }
+
+  try {
+    throw OutOfRange{"index ", 12, " out of range [", -1.5, ", ", 10u, ')'};
+  } catch (std::exception const &error) {
+    assert(std::string{error.what()} == "index 12 out of range [-1.5, 10)");
+  }
+
+  // Truncated: 7 characters and the null
+  FormattedError<8> const truncated{"abcd", "efgh"};
+  assert(std::string{truncated.what()} == "abcdefg");
+  FormattedError<8> const number{"abcd", 12'345};
+  assert(std::string{number.what()} == "abcd");
+
+  // Does not compile: the message must be a constant expression
+  // std::string text{"error"};
+  // StaticError error{text.c_str()};
+}
+
+auto allocations() -> void {
+  TRACE_FUNCTION();
+  if constexpr (runtime::allocation_tracking) {
+    runtime::AllocationScope const scope{};
+    StaticError const static_error{"static error"};
+    OutOfRange const formatted{"index ", 1'000, " out of range"};
+    assert(scope.stop().allocations == 0);
+    runtime::do_not_optimize(static_error);
+    runtime::do_not_optimize(formatted);
+
+    runtime::AllocationScope const string_scope{};
+    StringError const string_error{"index " + std::to_string(1'000) +
+                                   " out of range"};
+    assert(string_scope.stop().allocations > 0);
+    runtime::do_not_optimize(string_error);
+  }
+}
+
+// ____________________________________________________________________________
+// Benchmarks
+// Throw at `arg` frames below the catch, with the message "index <i> out of
+// range for size <n>":
+// - string: StringError, the message made of std::string temporaries
+// - formatted: FormattedError
+// - static: StaticError, without the numbers
+// - return_code: no exception, an error value returned by every frame
+// Catch clauses, at depth 1: the matching one is the first, or after 7
+// clauses of unrelated types
+
+template <typename Throw>
+[[gnu::noinline]] auto descend(long depth, Throw const &raise) -> long {
+  if (depth == 0) {
+    raise();
+    return 0;
+  }
+  // Not a tail call: every level keeps its frame
+  return descend(depth - 1, raise) + 1;
+}
+
+[[gnu::noinline]] auto descend_code(long depth) -> long {
+  if (depth == 0) {
+    return -1;
+  }
+  auto const result{descend_code(depth - 1)};
+  return result < 0 ? result : result + 1;
+}
+
+constexpr long bad_index{1'000};
+constexpr long array_size{10};
+
+template <typename Exception, typename Throw>
+auto throw_catch(runtime::State &state, Throw const &raise) -> void {
+  for (auto _ : state) {
+    try {
+      runtime::do_not_optimize(descend(state.arg(), raise));
+    } catch (Exception const &error) {
+      runtime::do_not_optimize(error.what());
+    }
+  }
+}
+
+auto bench_string(runtime::State &state) -> void {
+  throw_catch<StringError>(state, [] {
+    throw StringError{"index " + std::to_string(bad_index) +
+                      " out of range for size " + std::to_string(array_size)};
+  });
+}
+
+auto bench_formatted(runtime::State &state) -> void {
+  throw_catch<OutOfRange>(state, [] {
+    throw OutOfRange{"index ", bad_index, " out of range for size ",
+                     array_size};
+  });
+}
+
+auto bench_static(runtime::State &state) -> void {
+  throw_catch<StaticError>(state,
+                           [] { throw StaticError{"index out of range"}; });
+}
+
+auto bench_return_code(runtime::State &state) -> void {
+  for (auto _ : state) {
+    runtime::do_not_optimize(descend_code(state.arg()));
+  }
+}
+
+template <int> struct Unrelated : std::exception {};
+
+auto raise_static() -> void { throw StaticError{"index out of range"}; }
+
+auto bench_clauses_1(runtime::State &state) -> void {
+  for (auto _ : state) {
+    try {
+      runtime::do_not_optimize(descend(1, raise_static));
+    } catch (StaticError const &error) {
+      runtime::do_not_optimize(error.what());
+    }
+  }
+}
+
+auto bench_clauses_8(runtime::State &state) -> void {
+  for (auto _ : state) {
+    try {
+      runtime::do_not_optimize(descend(1, raise_static));
+    } catch (Unrelated<0> const &) {
+    } catch (Unrelated<1> const &) {
+    } catch (Unrelated<2> const &) {
+    } catch (Unrelated<3> const &) {
+    } catch (Unrelated<4> const &) {
+    } catch (Unrelated<5> const &) {
+    } catch (Unrelated<6> const &) {
+    } catch (StaticError const &error) {
+      runtime::do_not_optimize(error.what());
+    }
+  }
+}
+
+// ____________________________________________________________________________
+
+auto run() -> void {
+  messages();
+  allocations();
+}
+
+runtime::ModuleRegistrar const registrar{"fixed_exception", run};
+
+runtime::BenchmarkRegistrar const benchmarks[]{
+    {"fixed_exception::string", bench_string, {1, 10, 100}},
+    {"fixed_exception::formatted", bench_formatted, {1, 10, 100}},
+    {"fixed_exception::static", bench_static, {1, 10, 100}},
+    {"fixed_exception::return_code", bench_return_code, {1, 10, 100}},
+    {"fixed_exception::clauses_1", bench_clauses_1},
+    {"fixed_exception::clauses_8", bench_clauses_8},
+};
+
+} // namespace fixed_exception
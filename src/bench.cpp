@@ -0,0 +1,56 @@
+#include "runtime/arguments.h"
+#include "runtime/benchmark.h"
+#include "runtime/export.h"
+#include "runtime/profiler.h"
+#include <iostream>
+#include <stdexcept>
+
+constexpr auto usage{R"(usage: about-c-plus-plus-bench [options]
+  --list               print the registered benchmarks and exit
+  --filter <patterns>  run the benchmarks whose name contains one of the
+                       comma-separated patterns
+  --min-time <ms>      minimum duration of one sample (default 10)
+  --warmup <ms>        minimum duration of the calibration (default 50)
+  --max-time <ms>      time budget of the samples of a benchmark (default 2000)
+  --samples <n>        number of samples (default 20)
+  --max-arg <n>        skip arguments larger than n, 0 for none (default 1e7)
+  --counters           count cycles, instructions, branch, cache and TLB
+                       misses per iteration (Linux perf events)
+  --json <file>        write the results, samples and host metadata as JSON,
+                       the input of about-c-plus-plus-compare
+  --csv <file>         write the results and host metadata as CSV
+  --profile <file>     sample the call stacks and write them as folded stacks,
+                       the input of flame graph tools
+  --profile-hz <n>     samples per second of CPU time (default 997)
+)"};
+
+auto main(int argc, const char *argv[]) -> int try {
+  runtime::Arguments arguments{argc, argv};
+  if (arguments.flag("--help")) {
+    std::cout << usage;
+    return 0;
+  }
+  if (arguments.flag("--list")) {
+    for (auto const &benchmark : runtime::benchmarks()) {
+      std::cout << benchmark.name << '\n';
+    }
+    return 0;
+  }
+  auto const options{runtime::BenchmarkOptions::parse(arguments)};
+  auto const export_options{runtime::ExportOptions::parse(arguments)};
+  auto const profiler_options{runtime::ProfilerOptions::parse(arguments)};
+  arguments.finish();
+
+  runtime::ExportFiles exports{export_options};
+  runtime::start_profiler(profiler_options);
+
+  auto const results{runtime::run_benchmarks(options, std::cout)};
+  exports.write(results);
+  return 0;
+} catch (std::invalid_argument const &e) {
+  std::cerr << e.what() << '\n' << usage;
+  return -1;
+} catch (std::exception const &e) {
+  std::cerr << e.what() << '\n';
+  return -1;
+}
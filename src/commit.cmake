@@ -0,0 +1,19 @@
+# Writes OUTPUT, a header defining ABOUT_CPP_COMMIT as the commit of
+# SOURCE_DIR. Run at every build; the header is only rewritten when the
+# commit changes, so that an unchanged commit recompiles nothing
+set(ABOUT_CPP_COMMIT "")
+if(GIT_EXECUTABLE)
+  execute_process(
+      COMMAND ${GIT_EXECUTABLE} rev-parse --short HEAD
+      WORKING_DIRECTORY "${SOURCE_DIR}"
+      OUTPUT_VARIABLE ABOUT_CPP_COMMIT
+      OUTPUT_STRIP_TRAILING_WHITESPACE
+      ERROR_QUIET
+  )
+endif()
+if(NOT ABOUT_CPP_COMMIT)
+  set(ABOUT_CPP_COMMIT "unknown")
+endif()
+file(WRITE "${OUTPUT}.tmp" "#define ABOUT_CPP_COMMIT \"${ABOUT_CPP_COMMIT}\"\n")
+configure_file("${OUTPUT}.tmp" "${OUTPUT}" COPYONLY)
+file(REMOVE "${OUTPUT}.tmp")
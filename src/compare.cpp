@@ -0,0 +1,49 @@
+#include "runtime/arguments.h"
+#include "runtime/compare.h"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+constexpr auto usage{
+    R"(usage: about-c-plus-plus-compare [options] <baseline> <current>
+  Compares two files written by about-c-plus-plus-bench --json and exits
+  with status 1 if some benchmark regressed
+  --threshold <percent>  minimum slowdown of the median (default 5)
+  --alpha <level>        significance level of the test (default 0.01)
+)"};
+
+auto read_json(std::string const &path) -> runtime::Json {
+  std::ifstream file{path};
+  if (!file) {
+    throw std::invalid_argument{"cannot read " + path};
+  }
+  std::ostringstream text;
+  text << file.rdbuf();
+  return runtime::Json::parse(text.str());
+}
+
+auto main(int argc, const char *argv[]) -> int try {
+  runtime::Arguments arguments{argc, argv};
+  if (arguments.flag("--help")) {
+    std::cout << usage;
+    return 0;
+  }
+  auto const options{runtime::CompareOptions::parse(arguments)};
+  auto const files{arguments.positional()};
+  arguments.finish();
+  if (files.size() != 2) {
+    throw std::invalid_argument{"expected a baseline and a current file"};
+  }
+
+  auto const comparison{
+      runtime::compare(read_json(files[0]), read_json(files[1]), options)};
+  runtime::print_comparison(std::cout, comparison);
+  return comparison.regressions() > 0 ? 1 : 0;
+} catch (std::invalid_argument const &e) {
+  std::cerr << e.what() << '\n' << usage;
+  return -1;
+} catch (std::exception const &e) {
+  std::cerr << e.what() << '\n';
+  return -1;
+}
@@ -1,44 +1,10 @@
 #ifndef header_h
 #define header_h
 
+#include "runtime/benchmark.h"
+#include "runtime/module.h"
+#include "runtime/trace.h"
 #include <cassert>
 #include <string>
 
-namespace values_types {
-auto run() -> void;
-}
-namespace functions {
-auto run() -> void;
-}
-namespace namespaces {
-auto run() -> void;
-}
-namespace classes {
-auto run() -> void;
-}
-namespace hierarchies {
-auto run() -> void;
-}
-namespace operators {
-auto run() -> void;
-}
-namespace exceptions {
-auto run() -> void;
-}
-namespace templates {
-auto run() -> void;
-}
-namespace metaprogramming {
-auto run() -> void;
-}
-namespace casts {
-auto run() -> void;
-}
-namespace miscellaneous {
-auto run() -> void;
-}
-namespace interoperability {
-auto run() -> void;
-}
-
 #endif
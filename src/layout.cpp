@@ -0,0 +1,83 @@
+#include "1_basics/04_classes.h"
+#include "1_basics/06_hierarchies.h"
+#include "5_performance/04_layout.h"
+#include <iomanip>
+#include <iostream>
+
+// ____________________________________________________________________________
+// Descriptions of the classes of the examples
+
+namespace layout {
+
+template <>
+struct Description<classes::ClassWithMembers>
+    : Describe<Types<int, int const>> {};
+template <>
+struct Description<classes::MoveAndCopyClass> : Describe<Types<int *>> {};
+template <>
+struct Description<classes::MoveOnlyClass> : Describe<Types<int *>> {};
+template <>
+struct Description<classes::ConstAndLogicalConstnes>
+    : Describe<Types<int, int>> {};
+template <>
+struct Description<classes::ClassWithFriends> : Describe<Types<int>> {};
+template <> struct Description<classes::AStruct> : Describe<Types<>> {};
+template <>
+struct Description<classes::AUnion> : Describe<Types<int, float>> {};
+
+template <>
+struct Description<hierarchies::AbstractClass> : Describe<Types<>> {};
+template <> struct Description<hierarchies::ClassA> : Describe<Types<>> {};
+template <> struct Description<hierarchies::ClassB> : Describe<Types<>> {};
+template <>
+struct Description<hierarchies::Derived>
+    : Describe<Types<>, Types<hierarchies::AbstractClass, hierarchies::ClassA,
+                              hierarchies::ClassB>> {};
+template <>
+struct Description<hierarchies::FinalClass>
+    : Describe<Types<>, Types<hierarchies::Derived>> {};
+
+} // namespace layout
+
+// ____________________________________________________________________________
+
+constexpr layout::LayoutInfo layouts[]{
+    layout::layout_of<classes::ClassWithMembers>("classes::ClassWithMembers"),
+    layout::layout_of<classes::MoveAndCopyClass>("classes::MoveAndCopyClass"),
+    layout::layout_of<classes::MoveOnlyClass>("classes::MoveOnlyClass"),
+    layout::layout_of<classes::ConstAndLogicalConstnes>(
+        "classes::ConstAndLogicalConstnes"),
+    layout::layout_of<classes::ClassWithFriends>("classes::ClassWithFriends"),
+    layout::layout_of<classes::AStruct>("classes::AStruct"),
+    layout::layout_of<classes::AUnion>("classes::AUnion"),
+    layout::layout_of<hierarchies::AbstractClass>("hierarchies::AbstractClass"),
+    layout::layout_of<hierarchies::ClassA>("hierarchies::ClassA"),
+    layout::layout_of<hierarchies::ClassB>("hierarchies::ClassB"),
+    layout::layout_of<hierarchies::Derived>("hierarchies::Derived"),
+    layout::layout_of<hierarchies::FinalClass>("hierarchies::FinalClass"),
+    layout::layout_of<layout::Base>("layout::Base"),
+    layout::layout_of<layout::Diamond>("layout::Diamond"),
+    layout::layout_of<layout::VirtualLeft>("layout::VirtualLeft"),
+    layout::layout_of<layout::VirtualDiamond>("layout::VirtualDiamond"),
+    layout::layout_of<layout::FinalDiamond>("layout::FinalDiamond"),
+};
+
+auto main() -> int {
+  std::cout << std::left << std::setw(36) << "class" << std::right
+            << std::setw(6) << "size" << std::setw(7) << "align"
+            << std::setw(6) << "data" << std::setw(7) << "vptrs"
+            << std::setw(9) << "padding" << " traits\n";
+  for (auto const &layout : layouts) {
+    std::cout << std::left << std::setw(36) << layout.name << std::right
+              << std::setw(6) << layout.size << std::setw(7)
+              << layout.alignment << std::setw(6) << layout.data
+              << std::setw(7) << layout.vptrs << std::setw(9)
+              << layout.padding
+              << (layout.polymorphic ? " polymorphic" : "")
+              << (layout.standard_layout ? " standard-layout" : "")
+              << (layout.trivially_copyable ? " trivially-copyable" : "")
+              << '\n';
+  }
+  std::cout << "vptrs as laid out by the Itanium C++ ABI (GCC, Clang)\n";
+  return 0;
+}
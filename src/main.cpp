@@ -1,27 +1,53 @@
-#include "header.h"
+#include "runtime/arguments.h"
+#include "runtime/export.h"
+#include "runtime/profiler.h"
+#include "runtime/runner.h"
+#include "runtime/trace.h"
+#include <iostream>
+#include <stdexcept>
 
-auto run() -> void {
-  // basics
-  values_types::run();
-  functions::run();
-  namespaces::run();
-  classes::run();
-  hierarchies::run();
-  operators::run();
-  exceptions::run();
-  // templates
-  templates::run();
-  metaprogramming::run();
-  // interoperability
-  interoperability::run();
-  // other
-  casts::run();
-  miscellaneous::run();
-}
+constexpr auto usage{R"(usage: about-c-plus-plus [options]
+  --filter <patterns>  run the modules whose name contains one of the
+                       comma-separated patterns
+  --jobs <n>           number of modules executed concurrently
+  --counters           count cycles, instructions, branch, cache and TLB
+                       misses of each module (Linux perf events)
+  --json <file>        write the timings and host metadata as JSON
+  --csv <file>         write the timings and host metadata as CSV
+  --profile <file>     sample the call stacks and write them as folded stacks,
+                       the input of flame graph tools
+  --profile-hz <n>     samples per second of CPU time (default 997)
+  --trace <file>       record the modules and their functions as a Chrome
+                       trace (chrome://tracing, ui.perfetto.dev)
+)"};
 
 auto main(int argc, const char *argv[]) -> int try {
-  run();
+  runtime::Arguments arguments{argc, argv};
+  if (arguments.flag("--help")) {
+    std::cout << usage;
+    return 0;
+  }
+  auto const options{runtime::RunnerOptions::parse(arguments)};
+  auto const export_options{runtime::ExportOptions::parse(arguments)};
+  auto const profiler_options{runtime::ProfilerOptions::parse(arguments)};
+  auto const trace{arguments.value("--trace")};
+  arguments.finish();
+
+  runtime::ExportFiles exports{export_options};
+  runtime::start_profiler(profiler_options);
+
+  if (trace) {
+    runtime::start_tracing(*trace);
+  }
+
+  auto const report{runtime::run_modules(options)};
+  runtime::print_report(std::cout, report);
+  exports.write(report);
   return 0;
-} catch (...) {
+} catch (std::invalid_argument const &e) {
+  std::cerr << e.what() << '\n' << usage;
+  return -1;
+} catch (std::exception const &e) {
+  std::cerr << e.what() << '\n';
   return -1;
 }
@@ -0,0 +1,394 @@
+#include "allocations.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <new>
+#include <sstream>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#endif
+
+#if !defined(__linux__)
+#include <sys/resource.h>
+#endif
+
+#if ABOUT_CPP_TRACK_ALLOCATIONS && defined(__GLIBC__)
+// Entry points of the glibc allocator, not subject to interposition
+extern "C" {
+auto __libc_malloc(std::size_t size) -> void *;
+auto __libc_calloc(std::size_t count, std::size_t size) -> void *;
+auto __libc_realloc(void *pointer, std::size_t size) -> void *;
+auto __libc_memalign(std::size_t alignment, std::size_t size) -> void *;
+auto __libc_valloc(std::size_t size) -> void *;
+auto __libc_pvalloc(std::size_t size) -> void *;
+auto __libc_free(void *pointer) -> void;
+}
+#endif
+
+namespace runtime {
+
+// _____________________________________________________________________________
+// Counters
+
+struct ThreadAllocations {
+  std::size_t allocations;
+  std::size_t deallocations;
+  std::size_t bytes;
+  long long live;
+  long long peak;
+};
+
+// Constant-initialized and trivially destructible: usable from the allocator
+// at any time in the life of the thread
+constinit thread_local ThreadAllocations thread_allocations{};
+
+auto record_allocation(std::size_t size) -> void {
+  auto &counters{thread_allocations};
+  ++counters.allocations;
+  counters.bytes += size;
+  counters.live += static_cast<long long>(size);
+  counters.peak = std::max(counters.peak, counters.live);
+}
+
+auto record_deallocation(std::size_t size) -> void {
+  auto &counters{thread_allocations};
+  ++counters.deallocations;
+  counters.live -= static_cast<long long>(size);
+}
+
+AllocationScope::AllocationScope() {
+  auto &counters{thread_allocations};
+  _start = {counters.allocations, counters.deallocations, counters.bytes};
+  _live = counters.live;
+  counters.peak = counters.live;
+}
+
+auto AllocationScope::stop() const -> AllocationStats {
+  auto const &counters{thread_allocations};
+  return {counters.allocations - _start.allocations,
+          counters.deallocations - _start.deallocations,
+          counters.bytes - _start.bytes,
+          static_cast<std::size_t>(std::max(counters.peak - _live, 0ll))};
+}
+
+// _____________________________________________________________________________
+// Resident set size
+
+auto peak_rss() -> std::optional<std::size_t> {
+#if defined(__linux__)
+  std::ifstream status{"/proc/self/status"};
+  for (std::string line; std::getline(status, line);) {
+    if (line.starts_with("VmHWM:")) {
+      std::istringstream fields{line.substr(6)};
+      std::size_t kilobytes{};
+      if (fields >> kilobytes) {
+        return kilobytes * 1024;
+      }
+    }
+  }
+  return {};
+#else
+  rusage usage{};
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return {};
+  }
+#if defined(__APPLE__)
+  return static_cast<std::size_t>(usage.ru_maxrss);
+#else
+  return static_cast<std::size_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+// _____________________________________________________________________________
+// Formatting
+
+auto format_bytes(std::size_t bytes) -> std::string {
+  constexpr char const *units[]{"B", "KiB", "MiB", "GiB", "TiB"};
+  if (bytes < 1024) {
+    return std::to_string(bytes) + " B";
+  }
+  auto value{static_cast<double>(bytes)};
+  std::size_t unit{0};
+  while (value >= 1024 && unit + 1 < std::size(units)) {
+    value /= 1024;
+    ++unit;
+  }
+  std::ostringstream os;
+  os << std::fixed << std::setprecision(2) << value << ' ' << units[unit];
+  return os.str();
+}
+
+auto allocations_header() -> std::string {
+  std::ostringstream os;
+  os << std::setw(10) << "allocs" << std::setw(12) << "bytes" << std::setw(12)
+     << "peak";
+  return os.str();
+}
+
+auto format_allocations(AllocationStats const &stats) -> std::string {
+  std::ostringstream os;
+  os << std::setw(10) << stats.allocations << std::setw(12)
+     << format_bytes(stats.bytes) << std::setw(12) << format_bytes(stats.peak);
+  return os.str();
+}
+
+// _____________________________________________________________________________
+// Allocator
+// Every block is accounted with its usable size, known again when it is freed
+
+#if ABOUT_CPP_TRACK_ALLOCATIONS
+
+#if defined(__GLIBC__)
+
+auto usable_size(void *pointer) -> std::size_t {
+  return malloc_usable_size(pointer);
+}
+
+auto raw_allocate(std::size_t size, std::size_t alignment) -> void * {
+  return alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__
+             ? __libc_malloc(size)
+             : __libc_memalign(alignment, size);
+}
+
+auto raw_free(void *pointer) -> void { __libc_free(pointer); }
+
+#elif defined(__APPLE__)
+
+// The malloc family cannot be interposed from the executable: only the C++
+// allocations are counted
+
+auto usable_size(void *pointer) -> std::size_t { return malloc_size(pointer); }
+
+auto raw_allocate(std::size_t size, std::size_t alignment) -> void * {
+  if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+    return std::malloc(size);
+  }
+  // The size of aligned_alloc must be a multiple of the alignment
+  return std::aligned_alloc(alignment,
+                            (size + alignment - 1) / alignment * alignment);
+}
+
+auto raw_free(void *pointer) -> void { std::free(pointer); }
+
+#else
+#error "allocation tracking requires glibc or macOS"
+#endif
+
+auto tracked(void *pointer) -> void * {
+  if (pointer) {
+    record_allocation(usable_size(pointer));
+  }
+  return pointer;
+}
+
+auto tracked_free(void *pointer) -> void {
+  if (pointer) {
+    record_deallocation(usable_size(pointer));
+    raw_free(pointer);
+  }
+}
+
+// Semantics of the replaceable operator new: retries through the new-handler
+auto allocate(std::size_t size, std::size_t alignment) -> void * {
+  size = std::max<std::size_t>(size, 1);
+  while (true) {
+    if (auto pointer{raw_allocate(size, alignment)}) {
+      return tracked(pointer);
+    }
+    auto const handler{std::get_new_handler()};
+    if (!handler) {
+      throw std::bad_alloc{};
+    }
+    handler();
+  }
+}
+
+auto allocate(std::size_t size, std::size_t alignment,
+              std::nothrow_t const &) noexcept -> void * {
+  try {
+    return allocate(size, alignment);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+#endif
+
+} // namespace runtime
+
+#if ABOUT_CPP_TRACK_ALLOCATIONS
+
+// _____________________________________________________________________________
+// Replaceable allocation functions
+
+constexpr auto default_alignment{__STDCPP_DEFAULT_NEW_ALIGNMENT__};
+
+auto operator new(std::size_t size) -> void * {
+  return runtime::allocate(size, default_alignment);
+}
+
+auto operator new[](std::size_t size) -> void * {
+  return runtime::allocate(size, default_alignment);
+}
+
+auto operator new(std::size_t size, std::align_val_t alignment) -> void * {
+  return runtime::allocate(size, static_cast<std::size_t>(alignment));
+}
+
+auto operator new[](std::size_t size, std::align_val_t alignment) -> void * {
+  return runtime::allocate(size, static_cast<std::size_t>(alignment));
+}
+
+auto operator new(std::size_t size, std::nothrow_t const &tag) noexcept
+    -> void * {
+  return runtime::allocate(size, default_alignment, tag);
+}
+
+auto operator new[](std::size_t size, std::nothrow_t const &tag) noexcept
+    -> void * {
+  return runtime::allocate(size, default_alignment, tag);
+}
+
+auto operator new(std::size_t size, std::align_val_t alignment,
+                  std::nothrow_t const &tag) noexcept -> void * {
+  return runtime::allocate(size, static_cast<std::size_t>(alignment), tag);
+}
+
+auto operator new[](std::size_t size, std::align_val_t alignment,
+                    std::nothrow_t const &tag) noexcept -> void * {
+  return runtime::allocate(size, static_cast<std::size_t>(alignment), tag);
+}
+
+auto operator delete(void *pointer) noexcept -> void {
+  runtime::tracked_free(pointer);
+}
+
+auto operator delete[](void *pointer) noexcept -> void {
+  runtime::tracked_free(pointer);
+}
+
+auto operator delete(void *pointer, std::size_t) noexcept -> void {
+  runtime::tracked_free(pointer);
+}
+
+auto operator delete[](void *pointer, std::size_t) noexcept -> void {
+  runtime::tracked_free(pointer);
+}
+
+auto operator delete(void *pointer, std::align_val_t) noexcept -> void {
+  runtime::tracked_free(pointer);
+}
+
+auto operator delete[](void *pointer, std::align_val_t) noexcept -> void {
+  runtime::tracked_free(pointer);
+}
+
+auto operator delete(void *pointer, std::size_t, std::align_val_t) noexcept
+    -> void {
+  runtime::tracked_free(pointer);
+}
+
+auto operator delete[](void *pointer, std::size_t, std::align_val_t) noexcept
+    -> void {
+  runtime::tracked_free(pointer);
+}
+
+auto operator delete(void *pointer, std::nothrow_t const &) noexcept -> void {
+  runtime::tracked_free(pointer);
+}
+
+auto operator delete[](void *pointer, std::nothrow_t const &) noexcept
+    -> void {
+  runtime::tracked_free(pointer);
+}
+
+auto operator delete(void *pointer, std::align_val_t,
+                     std::nothrow_t const &) noexcept -> void {
+  runtime::tracked_free(pointer);
+}
+
+auto operator delete[](void *pointer, std::align_val_t,
+                       std::nothrow_t const &) noexcept -> void {
+  runtime::tracked_free(pointer);
+}
+
+#if defined(__GLIBC__)
+
+// _____________________________________________________________________________
+// C allocator
+// The functions glibc documents as replaceable, so that the allocations of the
+// C code and of the C library (strdup, ...) are counted too
+
+extern "C" {
+
+auto malloc(std::size_t size) noexcept -> void * {
+  return runtime::tracked(__libc_malloc(size));
+}
+
+auto calloc(std::size_t count, std::size_t size) noexcept -> void * {
+  return runtime::tracked(__libc_calloc(count, size));
+}
+
+auto realloc(void *pointer, std::size_t size) noexcept -> void * {
+  auto const old_size{pointer ? runtime::usable_size(pointer) : 0};
+  auto const result{__libc_realloc(pointer, size)};
+  // On failure the block is left untouched, unless the size is zero
+  if (pointer && (result || size == 0)) {
+    runtime::record_deallocation(old_size);
+  }
+  return runtime::tracked(result);
+}
+
+auto reallocarray(void *pointer, std::size_t count, std::size_t size) noexcept
+    -> void * {
+  std::size_t total{};
+  if (__builtin_mul_overflow(count, size, &total)) {
+    errno = ENOMEM;
+    return nullptr;
+  }
+  return realloc(pointer, total);
+}
+
+auto free(void *pointer) noexcept -> void { runtime::tracked_free(pointer); }
+
+auto memalign(std::size_t alignment, std::size_t size) noexcept -> void * {
+  return runtime::tracked(__libc_memalign(alignment, size));
+}
+
+auto aligned_alloc(std::size_t alignment, std::size_t size) noexcept
+    -> void * {
+  return runtime::tracked(__libc_memalign(alignment, size));
+}
+
+auto posix_memalign(void **result, std::size_t alignment,
+                    std::size_t size) noexcept -> int {
+  if (alignment % sizeof(void *) != 0 ||
+      (alignment & (alignment - 1)) != 0 || alignment == 0) {
+    return EINVAL;
+  }
+  auto const pointer{runtime::tracked(__libc_memalign(alignment, size))};
+  if (!pointer) {
+    return ENOMEM;
+  }
+  *result = pointer;
+  return 0;
+}
+
+auto valloc(std::size_t size) noexcept -> void * {
+  return runtime::tracked(__libc_valloc(size));
+}
+
+auto pvalloc(std::size_t size) noexcept -> void * {
+  return runtime::tracked(__libc_pvalloc(size));
+}
+}
+
+#endif
+
+#endif
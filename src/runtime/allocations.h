@@ -0,0 +1,58 @@
+#ifndef allocations_h
+#define allocations_h
+
+#include <cstddef>
+#include <optional>
+#include <string>
+
+// Set by the ABOUT_CPP_TRACK_ALLOCATIONS CMake option
+#ifndef ABOUT_CPP_TRACK_ALLOCATIONS
+#define ABOUT_CPP_TRACK_ALLOCATIONS 0
+#endif
+
+namespace runtime {
+
+// _____________________________________________________________________________
+// Heap allocations
+// With tracking enabled, the global operator new/delete and, on glibc, the
+// malloc family are replaced by versions counting the allocations of the
+// calling thread. Memory freed by another thread than the one allocating it is
+// accounted to the freeing thread
+
+inline constexpr bool allocation_tracking{ABOUT_CPP_TRACK_ALLOCATIONS != 0};
+
+struct AllocationStats {
+  std::size_t allocations{};
+  std::size_t deallocations{};
+  // Usable size of the allocated blocks, as reported by the allocator
+  std::size_t bytes{};
+  // Highest amount of live bytes above the level at the start of the scope
+  std::size_t peak{};
+};
+
+// Counts the allocations of the calling thread from construction to `stop()`.
+// Scopes of the same thread must not overlap
+class AllocationScope {
+public:
+  AllocationScope();
+
+  auto stop() const -> AllocationStats;
+
+private:
+  AllocationStats _start{};
+  long long _live{};
+};
+
+// Peak resident set size of the process, in bytes
+auto peak_rss() -> std::optional<std::size_t>;
+
+// Binary multiples: "512 B", "1.50 KiB", ...
+auto format_bytes(std::size_t bytes) -> std::string;
+
+// Fixed-width columns: allocations, allocated and peak live bytes
+auto allocations_header() -> std::string;
+auto format_allocations(AllocationStats const &stats) -> std::string;
+
+} // namespace runtime
+
+#endif
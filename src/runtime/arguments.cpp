@@ -0,0 +1,90 @@
+#include "arguments.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <iterator>
+#include <stdexcept>
+
+namespace runtime {
+
+Arguments::Arguments(int argc, const char *argv[])
+    : _arguments(argv + std::min(argc, 1), argv + argc) {}
+
+auto Arguments::flag(std::string_view name) -> bool {
+  auto it{std::find(_arguments.begin(), _arguments.end(), name)};
+  if (it == _arguments.end()) {
+    return false;
+  }
+  _arguments.erase(it);
+  return true;
+}
+
+auto Arguments::value(std::string_view name) -> std::optional<std::string> {
+  for (auto it{_arguments.begin()}; it != _arguments.end(); ++it) {
+    std::string_view argument{*it};
+    if (argument == name) {
+      if (std::next(it) == _arguments.end()) {
+        throw std::invalid_argument{"missing value for " + *it};
+      }
+      std::string value{*std::next(it)};
+      _arguments.erase(it, std::next(it, 2));
+      return value;
+    }
+    if (argument.starts_with(name) && argument.size() > name.size() &&
+        argument[name.size()] == '=') {
+      std::string value{argument.substr(name.size() + 1)};
+      _arguments.erase(it);
+      return value;
+    }
+  }
+  return std::nullopt;
+}
+
+auto Arguments::number(std::string_view name) -> std::optional<unsigned long> {
+  auto text{value(name)};
+  if (!text) {
+    return std::nullopt;
+  }
+  unsigned long number{};
+  auto const *last{text->data() + text->size()};
+  auto [end, error]{std::from_chars(text->data(), last, number)};
+  if (error != std::errc{} || end != last) {
+    throw std::invalid_argument{"invalid number for " + std::string{name} +
+                                ": " + *text};
+  }
+  return number;
+}
+
+auto Arguments::real(std::string_view name) -> std::optional<double> {
+  auto text{value(name)};
+  if (!text) {
+    return std::nullopt;
+  }
+  char *end{nullptr};
+  auto const real{std::strtod(text->c_str(), &end)};
+  if (text->empty() || end != text->c_str() + text->size()) {
+    throw std::invalid_argument{"invalid number for " + std::string{name} +
+                                ": " + *text};
+  }
+  return real;
+}
+
+auto Arguments::positional() -> std::vector<std::string> {
+  std::vector<std::string> positional{};
+  std::erase_if(_arguments, [&](std::string const &argument) {
+    if (argument.starts_with("--")) {
+      return false;
+    }
+    positional.push_back(argument);
+    return true;
+  });
+  return positional;
+}
+
+auto Arguments::finish() const -> void {
+  if (!_arguments.empty()) {
+    throw std::invalid_argument{"unknown argument: " + _arguments.front()};
+  }
+}
+
+} // namespace runtime
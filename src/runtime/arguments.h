@@ -0,0 +1,44 @@
+#ifndef arguments_h
+#define arguments_h
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace runtime {
+
+// _____________________________________________________________________________
+// Command-line arguments
+// Options have the form `--name`, `--name value` or `--name=value`. Each
+// subsystem consumes its own options; whatever is left is an error
+
+class Arguments {
+public:
+  Arguments(int argc, const char *argv[]);
+
+  // Consumes `--name`
+  auto flag(std::string_view name) -> bool;
+
+  // Consumes `--name value` or `--name=value`
+  auto value(std::string_view name) -> std::optional<std::string>;
+
+  // Like value() but converts to an unsigned number
+  auto number(std::string_view name) -> std::optional<unsigned long>;
+
+  // Like value() but converts to a floating-point number
+  auto real(std::string_view name) -> std::optional<double>;
+
+  // Consumes the arguments that are not options
+  auto positional() -> std::vector<std::string>;
+
+  // Throws std::invalid_argument if some argument was not consumed
+  auto finish() const -> void;
+
+private:
+  std::vector<std::string> _arguments;
+};
+
+} // namespace runtime
+
+#endif
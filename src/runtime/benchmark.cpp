@@ -0,0 +1,242 @@
+#include "benchmark.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <numeric>
+#include <ranges>
+#include <sstream>
+
+namespace runtime {
+
+// _____________________________________________________________________________
+// Options
+
+auto BenchmarkOptions::parse(Arguments &arguments) -> BenchmarkOptions {
+  BenchmarkOptions options{};
+  if (auto filter{arguments.value("--filter")}) {
+    for (auto pattern : std::views::split(*filter, ',')) {
+      options.filters.emplace_back(pattern.begin(), pattern.end());
+    }
+  }
+  if (auto ms{arguments.number("--min-time")}) {
+    options.min_time = std::chrono::milliseconds{*ms};
+  }
+  if (auto ms{arguments.number("--warmup")}) {
+    options.warmup = std::chrono::milliseconds{*ms};
+  }
+  if (auto ms{arguments.number("--max-time")}) {
+    options.max_time = std::chrono::milliseconds{*ms};
+  }
+  if (auto samples{arguments.number("--samples")}) {
+    options.samples = std::max(*samples, 1ul);
+  }
+  if (auto max_arg{arguments.number("--max-arg")}) {
+    options.max_arg = static_cast<long>(*max_arg);
+  }
+  options.counters = arguments.flag("--counters");
+  return options;
+}
+
+// _____________________________________________________________________________
+// State
+
+auto State::next_batch() -> std::size_t {
+  auto const now{Clock::now()};
+  auto const elapsed{now - _start - _paused};
+
+  if (_phase == Phase::idle) {
+    _phase = Phase::warmup;
+  } else if (_phase == Phase::warmup) {
+    // Grow the batch until one sample lasts at least min_time
+    _warmup += elapsed;
+    if (elapsed < _options.min_time) {
+      auto const ratio{elapsed.count() > 0 ? 1.4 * _options.min_time.count() /
+                                                 elapsed.count()
+                                           : 10.0};
+      auto const grown{
+          static_cast<std::size_t>(_batch * std::min(ratio, 10.0))};
+      _batch = std::max(_batch + 1, grown);
+    } else if (_warmup >= _options.warmup) {
+      _phase = Phase::measure;
+      _measure_start = now;
+      if (_counters) {
+        _counters->start();
+      }
+    }
+  } else if (_phase == Phase::measure) {
+    auto const ns{std::chrono::duration<double, std::nano>{elapsed}.count()};
+    _samples.push_back(ns / static_cast<double>(_batch));
+    if (_samples.size() >= _options.samples ||
+        (_samples.size() >= 3 && now - _measure_start >= _options.max_time)) {
+      _phase = Phase::done;
+      if (_counters) {
+        _readings = _counters->stop().divided_by(
+            static_cast<double>(_samples.size() * _batch));
+      }
+    }
+  }
+
+  if (_phase == Phase::done) {
+    return 0;
+  }
+  _paused = {};
+  _start = Clock::now();
+  return _batch;
+}
+
+// _____________________________________________________________________________
+// Registration
+
+auto registered_benchmarks() -> std::vector<Benchmark> & {
+  static std::vector<Benchmark> benchmarks{};
+  return benchmarks;
+}
+
+auto benchmarks() -> std::vector<Benchmark> const & {
+  return registered_benchmarks();
+}
+
+BenchmarkRegistrar::BenchmarkRegistrar(std::string_view name,
+                                       auto (*function)(State &)->void,
+                                       std::initializer_list<long> args,
+                                       std::source_location location) {
+  auto &benchmarks{registered_benchmarks()};
+  Benchmark entry{name, function, args, location.file_name()};
+  auto position{std::upper_bound(
+      benchmarks.begin(), benchmarks.end(), entry,
+      [](Benchmark const &lhs, Benchmark const &rhs) {
+        return lhs.file < rhs.file;
+      })};
+  benchmarks.insert(position, std::move(entry));
+}
+
+// _____________________________________________________________________________
+// Results
+
+auto summarize(std::string name, std::size_t iterations,
+               std::vector<double> samples) -> BenchmarkResult {
+  BenchmarkResult result{std::move(name), iterations, std::move(samples)};
+  if (result.samples.empty()) {
+    return result;
+  }
+
+  auto sorted{result.samples};
+  std::ranges::sort(sorted);
+  auto const n{sorted.size()};
+
+  result.mean = std::accumulate(sorted.begin(), sorted.end(), 0.0) / n;
+  result.median =
+      n % 2 ? sorted[n / 2] : (sorted[n / 2 - 1] + sorted[n / 2]) / 2;
+  // Nearest-rank percentile
+  result.p99 = sorted[static_cast<std::size_t>(std::ceil(0.99 * n)) - 1];
+  if (n > 1) {
+    auto const squares{std::accumulate(
+        sorted.begin(), sorted.end(), 0.0, [&](double sum, double sample) {
+          return sum + (sample - result.mean) * (sample - result.mean);
+        })};
+    result.stddev = std::sqrt(squares / (n - 1));
+  }
+  return result;
+}
+
+// Formats nanoseconds with a unit suited to their magnitude
+auto format_time(double ns) -> std::string {
+  std::ostringstream os;
+  os << std::fixed << std::setprecision(2);
+  if (ns < 1e3) {
+    os << ns << " ns";
+  } else if (ns < 1e6) {
+    os << ns / 1e3 << " us";
+  } else if (ns < 1e9) {
+    os << ns / 1e6 << " ms";
+  } else {
+    os << ns / 1e9 << " s";
+  }
+  return os.str();
+}
+
+auto format_throughput(BenchmarkResult const &result) -> std::string {
+  if (result.throughput_unit.empty() || result.median <= 0) {
+    return "";
+  }
+  std::ostringstream os;
+  os << std::fixed << std::setprecision(3)
+     << result.throughput / (result.median * 1e-9) << ' '
+     << result.throughput_unit << "/s";
+  return os.str();
+}
+
+auto print_header(std::ostream &os, bool counters) -> void {
+  os << std::left << std::setw(44) << "benchmark" << std::right
+     << std::setw(12) << "iterations" << std::setw(12) << "mean"
+     << std::setw(12) << "median" << std::setw(12) << "p99" << std::setw(12)
+     << "stddev";
+  if (counters) {
+    os << counters_header();
+  }
+  os << "  throughput\n";
+}
+
+auto print_result(std::ostream &os, BenchmarkResult const &result) -> void {
+  os << std::left << std::setw(44) << result.name << std::right
+     << std::setw(12) << result.iterations << std::setw(12)
+     << format_time(result.mean) << std::setw(12) << format_time(result.median)
+     << std::setw(12) << format_time(result.p99) << std::setw(12)
+     << format_time(result.stddev);
+  if (result.counters) {
+    os << format_counters(*result.counters);
+  }
+  os << "  " << format_throughput(result) << std::endl;
+}
+
+auto selected(BenchmarkOptions const &options, std::string_view name) -> bool {
+  return options.filters.empty() ||
+         std::ranges::any_of(options.filters, [&](std::string const &filter) {
+           return name.find(filter) != std::string_view::npos;
+         });
+}
+
+auto run_benchmarks(BenchmarkOptions const &options, std::ostream &os)
+    -> std::vector<BenchmarkResult> {
+  std::vector<BenchmarkResult> results{};
+
+  std::optional<PerfCounters> counters{};
+  if (options.counters) {
+    if (auto reason{counters_unavailable_reason()}; reason.empty()) {
+      counters.emplace();
+    } else {
+      os << reason << '\n';
+    }
+  }
+  print_header(os, counters.has_value());
+
+  auto run = [&](Benchmark const &benchmark, std::string name, long arg) {
+    if (!selected(options, name)) {
+      return;
+    }
+    State state{options, arg, counters ? &*counters : nullptr};
+    benchmark.function(state);
+    auto result{
+        summarize(std::move(name), state.iterations(), state.samples())};
+    result.throughput_unit = state.throughput_unit();
+    result.throughput = state.throughput();
+    result.counters = state.counters();
+    print_result(os, result);
+    results.push_back(std::move(result));
+  };
+
+  for (auto const &benchmark : benchmarks()) {
+    if (benchmark.args.empty()) {
+      run(benchmark, std::string{benchmark.name}, 0);
+    }
+    for (auto arg : benchmark.args) {
+      if (options.max_arg == 0 || arg <= options.max_arg) {
+        run(benchmark, std::string{benchmark.name} + '/' + std::to_string(arg),
+            arg);
+      }
+    }
+  }
+  return results;
+}
+
+} // namespace runtime
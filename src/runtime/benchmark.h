@@ -0,0 +1,223 @@
+#ifndef benchmark_h
+#define benchmark_h
+
+#include "arguments.h"
+#include "perf_counters.h"
+#include <chrono>
+#include <cstddef>
+#include <initializer_list>
+#include <optional>
+#include <ostream>
+#include <source_location>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace runtime {
+
+// _____________________________________________________________________________
+// Optimization barriers
+// Empty asm statements the compiler must assume read (and write) the value, so
+// that computations feeding it are neither removed nor hoisted out of loops
+
+template <typename T> inline auto do_not_optimize(T const &value) -> void {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+template <typename T> inline auto do_not_optimize(T &value) -> void {
+#if defined(__clang__)
+  asm volatile("" : "+r,m"(value) : : "memory");
+#else
+  asm volatile("" : "+m,r"(value) : : "memory");
+#endif
+}
+
+// Forces pending writes to memory to be considered observable
+inline auto clobber_memory() -> void { asm volatile("" : : : "memory"); }
+
+// _____________________________________________________________________________
+// Benchmark options
+
+struct BenchmarkOptions {
+  // Comma-separated substrings; a benchmark runs if its name contains any
+  std::vector<std::string> filters{};
+  // Minimum duration of one sample, the iteration count is calibrated on it
+  std::chrono::nanoseconds min_time{std::chrono::milliseconds{10}};
+  // Minimum duration of the calibration phase
+  std::chrono::nanoseconds warmup{std::chrono::milliseconds{50}};
+  // Time budget of the measurement phase, at least 3 samples are taken
+  std::chrono::nanoseconds max_time{std::chrono::seconds{2}};
+  std::size_t samples{20};
+  // Parameterized benchmarks skip arguments above this value (0: no limit)
+  long max_arg{10'000'000};
+  // Hardware counters over the samples
+  bool counters{false};
+
+  // Consumes `--filter`, `--min-time`, `--warmup`, `--max-time` (ms),
+  // `--samples`, `--max-arg` and `--counters`
+  static auto parse(Arguments &arguments) -> BenchmarkOptions;
+};
+
+// _____________________________________________________________________________
+// State
+// Drives the timed loop of a benchmark:
+//
+//   auto bench_something(runtime::State &state) -> void {
+//     auto input{setup(state.arg())};  // not timed
+//     for (auto _ : state) {           // warmup, calibration and samples
+//       runtime::do_not_optimize(something(input));
+//     }
+//   }
+
+class State {
+public:
+  struct Sentinel {};
+
+  // The loop variable: of a type marked unused, so that the loop does not
+  // warn in templates, where an int would
+  struct [[gnu::unused]] Iteration {};
+
+  class Iterator {
+  public:
+    explicit Iterator(State *state) : _state{state} {}
+
+    auto operator*() const -> Iteration { return {}; }
+
+    auto operator++() -> Iterator & {
+      --_remaining;
+      return *this;
+    }
+
+    auto operator!=(Sentinel) -> bool {
+      if (_remaining != 0) [[likely]] {
+        return true;
+      }
+      _remaining = _state->next_batch();
+      return _remaining != 0;
+    }
+
+  private:
+    State *_state;
+    std::size_t _remaining{0};
+  };
+
+  State(BenchmarkOptions const &options, long arg,
+        PerfCounters *counters = nullptr)
+      : _options{options}, _arg{arg}, _counters{counters} {}
+
+  auto begin() -> Iterator { return Iterator{this}; }
+  auto end() -> Sentinel { return {}; }
+
+  // Argument of parameterized benchmarks
+  auto arg() const -> long { return _arg; }
+
+  // Excludes the code between the two calls from the measurement
+  auto pause_timing() -> void {
+    _pause_start = Clock::now();
+    if (_counters) {
+      _counters->pause();
+    }
+  }
+  auto resume_timing() -> void {
+    if (_counters) {
+      _counters->resume();
+    }
+    _paused += Clock::now() - _pause_start;
+  }
+
+  // Reports `amount` units per iteration as a rate, e.g. ("GB", bytes / 1e9)
+  auto set_throughput(std::string_view unit, double amount) -> void {
+    _throughput_unit = unit;
+    _throughput = amount;
+  }
+
+  // Measurement, in nanoseconds per iteration of `iterations()` batches
+  auto samples() const -> std::vector<double> const & { return _samples; }
+  auto iterations() const -> std::size_t { return _batch; }
+  auto throughput_unit() const -> std::string const & {
+    return _throughput_unit;
+  }
+  auto throughput() const -> double { return _throughput; }
+  auto counters() const -> std::optional<CounterReadings> const & {
+    return _readings;
+  }
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  enum class Phase { idle, warmup, measure, done };
+
+  BenchmarkOptions const &_options;
+  long _arg;
+  PerfCounters *_counters;
+  std::optional<CounterReadings> _readings{};
+  Phase _phase{Phase::idle};
+  std::size_t _batch{1};
+  Clock::time_point _start{};
+  Clock::time_point _measure_start{};
+  Clock::time_point _pause_start{};
+  Clock::duration _paused{};
+  Clock::duration _warmup{};
+  std::vector<double> _samples{};
+  std::string _throughput_unit{};
+  double _throughput{};
+
+  // Closes the current batch, returns the size of the next one or 0
+  auto next_batch() -> std::size_t;
+};
+
+// _____________________________________________________________________________
+// Registration
+// Benchmarks register themselves next to the module they measure:
+//
+//   runtime::BenchmarkRegistrar const benchmarks[]{
+//       {"module::something", bench_something},
+//       {"module::sized", bench_sized, {1'000, 1'000'000}},
+//   };
+
+struct Benchmark {
+  std::string_view name;
+  auto (*function)(State &) -> void;
+  std::vector<long> args;
+  std::string_view file;
+};
+
+// Registered benchmarks, ordered by source file
+auto benchmarks() -> std::vector<Benchmark> const &;
+
+class BenchmarkRegistrar {
+public:
+  BenchmarkRegistrar(
+      std::string_view name, auto (*function)(State &)->void,
+      std::initializer_list<long> args = {},
+      std::source_location location = std::source_location::current());
+};
+
+// _____________________________________________________________________________
+// Results
+// Statistics are in nanoseconds per iteration
+
+struct BenchmarkResult {
+  std::string name;
+  std::size_t iterations{}; // per sample
+  std::vector<double> samples{};
+  double mean{};
+  double median{};
+  double p99{};
+  double stddev{};
+  std::string throughput_unit{};
+  double throughput{}; // units per iteration
+  std::optional<CounterReadings> counters{}; // per iteration
+};
+
+auto summarize(std::string name, std::size_t iterations,
+               std::vector<double> samples) -> BenchmarkResult;
+
+// Runs the selected benchmarks one at a time, printing each result as soon
+// as it is available
+auto run_benchmarks(BenchmarkOptions const &options, std::ostream &os)
+    -> std::vector<BenchmarkResult>;
+
+} // namespace runtime
+
+#endif
@@ -0,0 +1,233 @@
+#include "compare.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+
+namespace runtime {
+
+// _____________________________________________________________________________
+// Options
+
+auto CompareOptions::parse(Arguments &arguments) -> CompareOptions {
+  CompareOptions options{};
+  if (auto percent{arguments.real("--threshold")}) {
+    options.threshold = *percent / 100;
+  }
+  if (auto alpha{arguments.real("--alpha")}) {
+    options.alpha = *alpha;
+  }
+  if (options.threshold < 0 || options.alpha <= 0 || options.alpha >= 1) {
+    throw std::invalid_argument{"--threshold must be positive and --alpha "
+                                "between 0 and 1"};
+  }
+  return options;
+}
+
+auto Comparison::regressions() const -> std::size_t {
+  return std::ranges::count(differences, Verdict::regression,
+                            &Difference::verdict);
+}
+
+// _____________________________________________________________________________
+// Mann-Whitney U test
+
+auto mann_whitney_p_value(std::vector<double> const &x,
+                          std::vector<double> const &y) -> double {
+  auto const n1{static_cast<double>(x.size())};
+  auto const n2{static_cast<double>(y.size())};
+  if (x.empty() || y.empty()) {
+    return 1;
+  }
+
+  // Pool the samples, remembering which come from x
+  std::vector<std::pair<double, bool>> pooled{};
+  for (auto value : x) {
+    pooled.emplace_back(value, true);
+  }
+  for (auto value : y) {
+    pooled.emplace_back(value, false);
+  }
+  std::ranges::sort(pooled);
+
+  // Rank sum of x, ties get their average rank
+  auto rank_sum{0.0};
+  auto ties{0.0}; // sum of t^3 - t over groups of ties
+  for (std::size_t i{0}; i < pooled.size();) {
+    auto j{i};
+    while (j < pooled.size() && pooled[j].first == pooled[i].first) {
+      ++j;
+    }
+    auto const rank{(i + 1 + j) / 2.0};
+    for (auto k{i}; k < j; ++k) {
+      if (pooled[k].second) {
+        rank_sum += rank;
+      }
+    }
+    auto const t{static_cast<double>(j - i)};
+    ties += t * t * t - t;
+    i = j;
+  }
+
+  auto const n{n1 + n2};
+  auto const u{rank_sum - n1 * (n1 + 1) / 2};
+  auto const mean{n1 * n2 / 2};
+  auto const variance{n1 * n2 / 12 * ((n + 1) - ties / (n * (n - 1)))};
+  if (variance <= 0) {
+    return 1;
+  }
+  // Continuity correction
+  auto const z{std::max(std::abs(u - mean) - 0.5, 0.0) / std::sqrt(variance)};
+  return std::erfc(z / std::sqrt(2.0));
+}
+
+auto mann_whitney_min_p_value(std::size_t n1, std::size_t n2) -> double {
+  std::vector<double> x(n1);
+  std::vector<double> y(n2);
+  std::iota(x.begin(), x.end(), 0.0);
+  std::iota(y.begin(), y.end(), static_cast<double>(n1));
+  return mann_whitney_p_value(x, y);
+}
+
+// _____________________________________________________________________________
+// Comparison
+
+auto samples(Json const &benchmark) -> std::vector<double> {
+  std::vector<double> samples{};
+  if (!benchmark["samples_ns"].is_null()) {
+    for (auto const &sample : benchmark["samples_ns"].as_array()) {
+      samples.push_back(sample.as_number());
+    }
+  }
+  return samples;
+}
+
+auto find(Json::Array const &benchmarks, std::string const &name)
+    -> Json const * {
+  auto it{std::ranges::find_if(benchmarks, [&](Json const &benchmark) {
+    return benchmark["name"].as_string() == name;
+  })};
+  return it == benchmarks.end() ? nullptr : &*it;
+}
+
+auto compare(Json const &baseline, Json const &current,
+             CompareOptions const &options) -> Comparison {
+  Comparison comparison{};
+
+  for (auto key : {"cpu", "compiler", "flags", "build_type"}) {
+    auto const &before{baseline["host"][key]};
+    auto const &after{current["host"][key]};
+    if (!before.is_null() && !after.is_null() &&
+        before.as_string() != after.as_string()) {
+      comparison.notes.push_back(std::string{key} + " differs: " +
+                                 before.as_string() + " -> " +
+                                 after.as_string());
+    }
+  }
+
+  auto const &before{baseline["benchmarks"].as_array()};
+  auto const &after{current["benchmarks"].as_array()};
+  std::size_t underpowered{0};
+
+  for (auto const &benchmark : after) {
+    Difference difference{benchmark["name"].as_string()};
+    difference.current = benchmark["median_ns"].as_number();
+    auto const *previous{find(before, difference.name)};
+    if (previous == nullptr) {
+      difference.verdict = Verdict::added;
+      comparison.differences.push_back(std::move(difference));
+      continue;
+    }
+    difference.baseline = (*previous)["median_ns"].as_number();
+    difference.change = difference.baseline > 0
+                            ? difference.current / difference.baseline - 1
+                            : 0;
+    auto const baseline_samples{samples(*previous)};
+    auto const current_samples{samples(benchmark)};
+    if (mann_whitney_min_p_value(baseline_samples.size(),
+                                 current_samples.size()) >= options.alpha) {
+      ++underpowered;
+    }
+    difference.p_value =
+        mann_whitney_p_value(baseline_samples, current_samples);
+    if (difference.p_value < options.alpha) {
+      if (difference.change > options.threshold) {
+        difference.verdict = Verdict::regression;
+      } else if (difference.change < -options.threshold) {
+        difference.verdict = Verdict::improvement;
+      }
+    }
+    comparison.differences.push_back(std::move(difference));
+  }
+
+  for (auto const &benchmark : before) {
+    if (find(after, benchmark["name"].as_string()) == nullptr) {
+      Difference difference{benchmark["name"].as_string()};
+      difference.baseline = benchmark["median_ns"].as_number();
+      difference.verdict = Verdict::removed;
+      comparison.differences.push_back(std::move(difference));
+    }
+  }
+
+  if (underpowered > 0) {
+    // The samples per run that reach alpha
+    std::size_t needed{1};
+    while (needed < 1'000 &&
+           mann_whitney_min_p_value(needed, needed) >= options.alpha) {
+      ++needed;
+    }
+    std::ostringstream warning{};
+    warning << underpowered << " benchmarks have too few samples to reach "
+            << "alpha " << options.alpha << ", never flagged: run with "
+            << "--samples " << needed << " or more";
+    comparison.warnings.push_back(warning.str());
+  }
+  return comparison;
+}
+
+// _____________________________________________________________________________
+
+auto verdict_name(Verdict verdict) -> char const * {
+  switch (verdict) {
+  case Verdict::unchanged:
+    return "";
+  case Verdict::improvement:
+    return "improvement";
+  case Verdict::regression:
+    return "REGRESSION";
+  case Verdict::added:
+    return "added";
+  case Verdict::removed:
+    return "removed";
+  }
+  return "";
+}
+
+auto print_comparison(std::ostream &os, Comparison const &comparison)
+    -> void {
+  auto const flags{os.flags()};
+  for (auto const &note : comparison.notes) {
+    os << "note: " << note << '\n';
+  }
+  for (auto const &warning : comparison.warnings) {
+    os << "warning: " << warning << '\n';
+  }
+  os << std::left << std::setw(44) << "benchmark" << std::right
+     << std::setw(14) << "baseline [ns]" << std::setw(14) << "current [ns]"
+     << std::setw(10) << "change" << std::setw(10) << "p-value" << '\n';
+  for (auto const &difference : comparison.differences) {
+    os << std::left << std::setw(44) << difference.name << std::right
+       << std::fixed << std::setprecision(2) << std::setw(14)
+       << difference.baseline << std::setw(14) << difference.current
+       << std::setw(9) << std::showpos << difference.change * 100 << '%'
+       << std::noshowpos << std::setprecision(4) << std::setw(10)
+       << difference.p_value << "  " << verdict_name(difference.verdict)
+       << '\n';
+  }
+  os << comparison.regressions() << " regressions\n";
+  os.flags(flags);
+}
+
+} // namespace runtime
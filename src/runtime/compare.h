@@ -0,0 +1,64 @@
+#ifndef compare_h
+#define compare_h
+
+#include "arguments.h"
+#include "json.h"
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace runtime {
+
+// _____________________________________________________________________________
+// Comparison of benchmark results
+// A benchmark regresses when its median slows down by more than the threshold
+// and a Mann-Whitney U test over the samples rejects, at the significance
+// level, that both runs come from the same distribution. The rank test does
+// not assume normality, so a few noisy samples do not decide the outcome
+
+struct CompareOptions {
+  double threshold{0.05}; // relative change of the median
+  double alpha{0.01};     // significance level
+
+  // Consumes `--threshold <percent>` and `--alpha <level>`
+  static auto parse(Arguments &arguments) -> CompareOptions;
+};
+
+enum class Verdict { unchanged, improvement, regression, added, removed };
+
+struct Difference {
+  std::string name;
+  double baseline{}; // median, ns
+  double current{};  // median, ns
+  double change{};   // relative
+  double p_value{1};
+  Verdict verdict{Verdict::unchanged};
+};
+
+struct Comparison {
+  std::vector<Difference> differences{};
+  // Host metadata that differs between the files
+  std::vector<std::string> notes{};
+  // Benchmarks the test cannot flag, with too few samples to reach alpha
+  std::vector<std::string> warnings{};
+
+  auto regressions() const -> std::size_t;
+};
+
+// Two-sided p-value, normal approximation with tie correction
+auto mann_whitney_p_value(std::vector<double> const &x,
+                          std::vector<double> const &y) -> double;
+
+// Smallest p-value for samples of sizes n1 and n2, when all the samples of
+// one are below those of the other: 0.0122 for 5 and 5, 0.0051 for 6 and 6
+auto mann_whitney_min_p_value(std::size_t n1, std::size_t n2) -> double;
+
+// Compares result files written by about-c-plus-plus-bench --json
+auto compare(Json const &baseline, Json const &current,
+             CompareOptions const &options) -> Comparison;
+
+auto print_comparison(std::ostream &os, Comparison const &comparison) -> void;
+
+} // namespace runtime
+
+#endif
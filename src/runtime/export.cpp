@@ -0,0 +1,362 @@
+#include "export.h"
+#include "json.h"
+#include <charconv>
+#include <chrono>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+
+#if defined(__APPLE__)
+#include <sys/sysctl.h>
+#endif
+
+// Defined by the build system, the commit in a header generated at every
+// build
+#if __has_include("commit.h")
+#include "commit.h"
+#endif
+#ifndef ABOUT_CPP_COMMIT
+#define ABOUT_CPP_COMMIT "unknown"
+#endif
+#ifndef ABOUT_CPP_BUILD_TYPE
+#define ABOUT_CPP_BUILD_TYPE "unknown"
+#endif
+#ifndef ABOUT_CPP_FLAGS
+#define ABOUT_CPP_FLAGS ""
+#endif
+
+namespace runtime {
+
+// _____________________________________________________________________________
+// Host metadata
+
+auto cpu_model() -> std::string {
+#if defined(__APPLE__)
+  char brand[256]{};
+  auto size{sizeof(brand)};
+  if (sysctlbyname("machdep.cpu.brand_string", brand, &size, nullptr, 0) ==
+      0) {
+    return brand;
+  }
+#else
+  std::ifstream cpuinfo{"/proc/cpuinfo"};
+  for (std::string line; std::getline(cpuinfo, line);) {
+    if (line.starts_with("model name")) {
+      auto const colon{line.find(':')};
+      return line.substr(line.find_first_not_of(' ', colon + 1));
+    }
+  }
+#endif
+  return "unknown";
+}
+
+auto compiler() -> std::string {
+#if defined(__clang__)
+  return "clang " __clang_version__;
+#elif defined(__GNUC__)
+  return "gcc " __VERSION__;
+#else
+  return "unknown";
+#endif
+}
+
+auto utc_timestamp() -> std::string {
+  auto const now{std::chrono::system_clock::to_time_t(
+      std::chrono::system_clock::now())};
+  std::tm tm{};
+  gmtime_r(&now, &tm);
+  char buffer[32];
+  std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%SZ", &tm);
+  return buffer;
+}
+
+auto host_info() -> HostInfo {
+  return {cpu_model(),          std::thread::hardware_concurrency(),
+          compiler(),           ABOUT_CPP_FLAGS,
+          ABOUT_CPP_BUILD_TYPE, ABOUT_CPP_COMMIT,
+          utc_timestamp()};
+}
+
+// _____________________________________________________________________________
+// Options
+
+auto ExportOptions::parse(Arguments &arguments) -> ExportOptions {
+  ExportOptions options{};
+  options.json = arguments.value("--json").value_or("");
+  options.csv = arguments.value("--csv").value_or("");
+  return options;
+}
+
+// _____________________________________________________________________________
+// JSON
+
+// Shortest representation that reads back to the same value
+auto number(double value) -> std::string {
+  char buffer[32];
+  auto const [end, error]{
+      std::to_chars(buffer, buffer + sizeof(buffer), value)};
+  return {buffer, end};
+}
+
+auto write_host(std::ostream &os, HostInfo const &host) -> void {
+  os << "  \"host\": {\n"
+     << "    \"cpu\": " << quoted(host.cpu) << ",\n"
+     << "    \"threads\": " << host.threads << ",\n"
+     << "    \"compiler\": " << quoted(host.compiler) << ",\n"
+     << "    \"flags\": " << quoted(host.flags) << ",\n"
+     << "    \"build_type\": " << quoted(host.build_type) << ",\n"
+     << "    \"commit\": " << quoted(host.commit) << ",\n"
+     << "    \"timestamp\": " << quoted(host.timestamp) << "\n"
+     << "  }";
+}
+
+auto write_counters(std::ostream &os, CounterReadings const &readings)
+    -> void {
+  os << ", \"counters\": {";
+  auto separator{""};
+  for (std::size_t i{0}; i < event_count; ++i) {
+    if (readings.values[i]) {
+      os << separator << quoted(event_names[i]) << ": "
+         << number(*readings.values[i]);
+      separator = ", ";
+    }
+  }
+  os << '}';
+}
+
+auto write_allocations(std::ostream &os, AllocationStats const &stats)
+    -> void {
+  os << ", \"allocations\": {\"count\": " << stats.allocations
+     << ", \"deallocations\": " << stats.deallocations
+     << ", \"bytes\": " << stats.bytes << ", \"peak_bytes\": " << stats.peak
+     << '}';
+}
+
+auto write_json(std::ostream &os, HostInfo const &host,
+                RunReport const &report) -> void {
+  os << "{\n";
+  write_host(os, host);
+  os << ",\n  \"jobs\": " << report.jobs << ",\n  \"wall_ns\": "
+     << report.wall.count();
+  if (report.peak_rss) {
+    os << ",\n  \"peak_rss_bytes\": " << *report.peak_rss;
+  }
+  os << ",\n  \"modules\": [";
+  auto separator{"\n"};
+  for (auto const &result : report.modules) {
+    os << separator << "    {\"name\": " << quoted(result.module->name)
+       << ", \"wall_ns\": " << result.wall.count();
+    if (result.allocations) {
+      write_allocations(os, *result.allocations);
+    }
+    if (result.counters) {
+      write_counters(os, *result.counters);
+    }
+    os << '}';
+    separator = ",\n";
+  }
+  os << "\n  ]\n}\n";
+}
+
+auto write_json(std::ostream &os, HostInfo const &host,
+                std::vector<BenchmarkResult> const &results) -> void {
+  os << "{\n";
+  write_host(os, host);
+  os << ",\n  \"benchmarks\": [";
+  auto separator{"\n"};
+  for (auto const &result : results) {
+    os << separator << "    {\"name\": " << quoted(result.name)
+       << ", \"iterations\": " << result.iterations
+       << ", \"mean_ns\": " << number(result.mean)
+       << ", \"median_ns\": " << number(result.median)
+       << ", \"p99_ns\": " << number(result.p99)
+       << ", \"stddev_ns\": " << number(result.stddev);
+    if (!result.throughput_unit.empty()) {
+      os << ", \"throughput\": {\"unit\": " << quoted(result.throughput_unit)
+         << ", \"per_iteration\": " << number(result.throughput) << '}';
+    }
+    if (result.counters) {
+      write_counters(os, *result.counters);
+    }
+    os << ",\n     \"samples_ns\": [";
+    auto sample_separator{""};
+    for (auto sample : result.samples) {
+      os << sample_separator << number(sample);
+      sample_separator = ", ";
+    }
+    os << "]}";
+    separator = ",\n";
+  }
+  os << "\n  ]\n}\n";
+}
+
+// _____________________________________________________________________________
+// CSV
+
+// Quotes a field if needed
+auto field(std::string_view text) -> std::string {
+  if (text.find_first_of(",\"\n") == std::string_view::npos) {
+    return std::string{text};
+  }
+  std::string quoted_field{'"'};
+  for (auto c : text) {
+    quoted_field += c;
+    if (c == '"') {
+      quoted_field += '"';
+    }
+  }
+  return quoted_field + '"';
+}
+
+auto write_csv_host(std::ostream &os, HostInfo const &host) -> void {
+  os << "# cpu: " << host.cpu << '\n'
+     << "# threads: " << host.threads << '\n'
+     << "# compiler: " << host.compiler << '\n'
+     << "# flags: " << host.flags << '\n'
+     << "# build_type: " << host.build_type << '\n'
+     << "# commit: " << host.commit << '\n'
+     << "# timestamp: " << host.timestamp << '\n';
+}
+
+auto write_csv_counters_header(std::ostream &os) -> void {
+  for (auto name : event_names) {
+    os << ',' << name;
+  }
+  os << '\n';
+}
+
+auto write_csv_counters(std::ostream &os,
+                        std::optional<CounterReadings> const &readings)
+    -> void {
+  for (std::size_t i{0}; i < event_count; ++i) {
+    os << ',';
+    if (readings && readings->values[i]) {
+      os << number(*readings->values[i]);
+    }
+  }
+  os << '\n';
+}
+
+auto write_csv(std::ostream &os, HostInfo const &host,
+               RunReport const &report) -> void {
+  write_csv_host(os, host);
+  if (report.peak_rss) {
+    os << "# peak_rss_bytes: " << *report.peak_rss << '\n';
+  }
+  os << "module,wall_ns,allocations,deallocations,bytes,peak_bytes";
+  write_csv_counters_header(os);
+  for (auto const &result : report.modules) {
+    os << field(result.module->name) << ',' << result.wall.count();
+    if (auto const &stats{result.allocations}) {
+      os << ',' << stats->allocations << ',' << stats->deallocations << ','
+         << stats->bytes << ',' << stats->peak;
+    } else {
+      os << ",,,,";
+    }
+    write_csv_counters(os, result.counters);
+  }
+}
+
+auto write_csv(std::ostream &os, HostInfo const &host,
+               std::vector<BenchmarkResult> const &results) -> void {
+  write_csv_host(os, host);
+  os << "benchmark,iterations,samples,mean_ns,median_ns,p99_ns,stddev_ns,"
+        "throughput_unit,throughput_per_iteration";
+  write_csv_counters_header(os);
+  for (auto const &result : results) {
+    os << field(result.name) << ',' << result.iterations << ','
+       << result.samples.size() << ',' << number(result.mean) << ','
+       << number(result.median) << ',' << number(result.p99) << ','
+       << number(result.stddev) << ',' << field(result.throughput_unit) << ','
+       << (result.throughput_unit.empty() ? "" : number(result.throughput));
+    write_csv_counters(os, result.counters);
+  }
+}
+
+// _____________________________________________________________________________
+
+auto temporary_path(PendingFile const &file) -> std::string {
+  return file.path + ".tmp";
+}
+
+auto open_pending(std::string const &path) -> std::optional<PendingFile> {
+  if (path.empty()) {
+    return std::nullopt;
+  }
+  PendingFile file{path, {}};
+  file.stream.open(temporary_path(file));
+  if (!file.stream) {
+    throw std::runtime_error{"cannot write " + path};
+  }
+  return file;
+}
+
+auto discard(std::optional<PendingFile> &file) -> void {
+  if (file) {
+    file->stream.close();
+    std::error_code error{};
+    std::filesystem::remove(temporary_path(*file), error);
+    file.reset();
+  }
+}
+
+// Flushes and closes the file, then replaces `path` with it
+auto complete(std::optional<PendingFile> &file) -> void {
+  if (!file) {
+    return;
+  }
+  file->stream.close();
+  std::error_code error{};
+  if (file->stream) {
+    std::filesystem::rename(temporary_path(*file), file->path, error);
+  }
+  if (!file->stream || error) {
+    auto const path{file->path};
+    discard(file);
+    throw std::runtime_error{"cannot write " + path};
+  }
+  file.reset();
+}
+
+ExportFiles::ExportFiles(ExportOptions const &options)
+    : _json{open_pending(options.json)} {
+  try {
+    _csv = open_pending(options.csv);
+  } catch (...) {
+    discard(_json);
+    throw;
+  }
+}
+
+ExportFiles::~ExportFiles() {
+  discard(_json);
+  discard(_csv);
+}
+
+template <typename Results>
+auto export_to(std::optional<PendingFile> &json,
+               std::optional<PendingFile> &csv, Results const &results)
+    -> void {
+  auto const host{host_info()};
+  if (json) {
+    write_json(json->stream, host, results);
+  }
+  if (csv) {
+    write_csv(csv->stream, host, results);
+  }
+  complete(json);
+  complete(csv);
+}
+
+auto ExportFiles::write(RunReport const &report) -> void {
+  export_to(_json, _csv, report);
+}
+
+auto ExportFiles::write(std::vector<BenchmarkResult> const &results) -> void {
+  export_to(_json, _csv, results);
+}
+
+} // namespace runtime
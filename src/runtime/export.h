@@ -0,0 +1,85 @@
+#ifndef export_h
+#define export_h
+
+#include "arguments.h"
+#include "benchmark.h"
+#include "runner.h"
+#include <fstream>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace runtime {
+
+// _____________________________________________________________________________
+// Host metadata
+// Recorded with the results so that files from different machines and builds
+// are not compared unknowingly
+
+struct HostInfo {
+  std::string cpu;
+  unsigned threads;
+  std::string compiler;
+  std::string flags;
+  std::string build_type;
+  std::string commit;
+  std::string timestamp; // UTC, ISO 8601
+};
+
+auto host_info() -> HostInfo;
+
+// _____________________________________________________________________________
+// Export
+// JSON holds everything, samples included; CSV holds one row per module or
+// benchmark, preceded by `# key: value` lines with the host metadata
+
+struct ExportOptions {
+  std::string json{};
+  std::string csv{};
+
+  // Consumes `--json <file>` and `--csv <file>`
+  static auto parse(Arguments &arguments) -> ExportOptions;
+};
+
+auto write_json(std::ostream &os, HostInfo const &host,
+                RunReport const &report) -> void;
+auto write_json(std::ostream &os, HostInfo const &host,
+                std::vector<BenchmarkResult> const &results) -> void;
+
+auto write_csv(std::ostream &os, HostInfo const &host,
+               RunReport const &report) -> void;
+auto write_csv(std::ostream &os, HostInfo const &host,
+               std::vector<BenchmarkResult> const &results) -> void;
+
+// A file written as `path`.tmp and renamed to `path` once complete: a run
+// that fails leaves the previous file in place
+struct PendingFile {
+  std::string path;
+  std::ofstream stream;
+};
+
+// The requested files, opened when constructed, before the run: a path that
+// cannot be written throws std::runtime_error before the results are computed.
+// write() throws it too when a file cannot be completed, the destructor
+// removes the temporary files of the ones not completed
+class ExportFiles {
+public:
+  explicit ExportFiles(ExportOptions const &options);
+
+  ~ExportFiles();
+
+  ExportFiles(ExportFiles const &) = delete;
+  ExportFiles &operator=(ExportFiles const &) = delete;
+
+  auto write(RunReport const &report) -> void;
+  auto write(std::vector<BenchmarkResult> const &results) -> void;
+
+private:
+  std::optional<PendingFile> _json;
+  std::optional<PendingFile> _csv;
+};
+
+} // namespace runtime
+
+#endif
@@ -0,0 +1,267 @@
+#include "json.h"
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace runtime {
+
+// _____________________________________________________________________________
+// Parser
+
+class Parser {
+public:
+  explicit Parser(std::string_view text) : _text{text} {}
+
+  auto document() -> Json {
+    auto value{parse_value()};
+    skip_whitespace();
+    if (_position != _text.size()) {
+      fail("trailing characters");
+    }
+    return value;
+  }
+
+private:
+  std::string_view _text;
+  std::size_t _position{0};
+
+  [[noreturn]] auto fail(std::string const &message) const -> void {
+    throw std::invalid_argument{"invalid JSON at offset " +
+                                std::to_string(_position) + ": " + message};
+  }
+
+  auto skip_whitespace() -> void {
+    while (_position < _text.size() &&
+           (_text[_position] == ' ' || _text[_position] == '\n' ||
+            _text[_position] == '\r' || _text[_position] == '\t')) {
+      ++_position;
+    }
+  }
+
+  auto peek() -> char {
+    skip_whitespace();
+    if (_position == _text.size()) {
+      fail("unexpected end");
+    }
+    return _text[_position];
+  }
+
+  auto expect(char c) -> void {
+    if (peek() != c) {
+      fail(std::string{"expected '"} + c + "'");
+    }
+    ++_position;
+  }
+
+  auto consume(std::string_view literal) -> bool {
+    if (_text.substr(_position, literal.size()) != literal) {
+      return false;
+    }
+    _position += literal.size();
+    return true;
+  }
+
+  auto parse_value() -> Json {
+    switch (peek()) {
+    case '{':
+      return parse_object();
+    case '[':
+      return parse_array();
+    case '"':
+      return parse_string();
+    default:
+      break;
+    }
+    if (consume("null")) {
+      return nullptr;
+    }
+    if (consume("true")) {
+      return true;
+    }
+    if (consume("false")) {
+      return false;
+    }
+    return parse_number();
+  }
+
+  auto parse_object() -> Json {
+    expect('{');
+    Json::Object object{};
+    if (peek() == '}') {
+      ++_position;
+      return object;
+    }
+    while (true) {
+      auto key{parse_string()};
+      expect(':');
+      object.emplace_back(std::move(key), parse_value());
+      if (peek() != ',') {
+        break;
+      }
+      ++_position;
+    }
+    expect('}');
+    return object;
+  }
+
+  auto parse_array() -> Json {
+    expect('[');
+    Json::Array array{};
+    if (peek() == ']') {
+      ++_position;
+      return array;
+    }
+    while (true) {
+      array.push_back(parse_value());
+      if (peek() != ',') {
+        break;
+      }
+      ++_position;
+    }
+    expect(']');
+    return array;
+  }
+
+  auto parse_string() -> std::string {
+    expect('"');
+    std::string string{};
+    while (_position < _text.size() && _text[_position] != '"') {
+      auto c{_text[_position++]};
+      if (c != '\\') {
+        string += c;
+        continue;
+      }
+      if (_position == _text.size()) {
+        break;
+      }
+      switch (auto escaped{_text[_position++]}) {
+      case 'n':
+        string += '\n';
+        break;
+      case 't':
+        string += '\t';
+        break;
+      case 'r':
+        string += '\r';
+        break;
+      case 'b':
+        string += '\b';
+        break;
+      case 'f':
+        string += '\f';
+        break;
+      case 'u': {
+        // Only the code points quoted() produces: control characters
+        auto const hex{std::string{_text.substr(_position, 4)}};
+        _position += 4;
+        string += static_cast<char>(std::strtol(hex.c_str(), nullptr, 16));
+        break;
+      }
+      default:
+        string += escaped;
+      }
+    }
+    if (_position == _text.size()) {
+      fail("unterminated string");
+    }
+    ++_position;
+    return string;
+  }
+
+  auto parse_number() -> Json {
+    auto const begin{_text.data() + _position};
+    // The text is not null-terminated: copy the longest numeric prefix
+    auto length{_text.find_first_not_of("+-0123456789.eE", _position)};
+    length = (length == std::string_view::npos ? _text.size() : length) -
+             _position;
+    std::string number{begin, length};
+    char *end{nullptr};
+    auto const value{std::strtod(number.c_str(), &end)};
+    if (number.empty() || end != number.c_str() + number.size()) {
+      fail("invalid value");
+    }
+    _position += length;
+    return value;
+  }
+};
+
+auto Json::parse(std::string_view text) -> Json {
+  return Parser{text}.document();
+}
+
+// _____________________________________________________________________________
+// Accessors
+
+template <typename T>
+auto get(std::variant<std::nullptr_t, bool, double, std::string, Json::Array,
+                      Json::Object> const &value,
+         char const *type) -> T const & {
+  if (auto const *alternative{std::get_if<T>(&value)}) {
+    return *alternative;
+  }
+  throw std::invalid_argument{std::string{"JSON value is not "} + type};
+}
+
+auto Json::as_bool() const -> bool { return get<bool>(_value, "a boolean"); }
+
+auto Json::as_number() const -> double {
+  return get<double>(_value, "a number");
+}
+
+auto Json::as_string() const -> std::string const & {
+  return get<std::string>(_value, "a string");
+}
+
+auto Json::as_array() const -> Array const & {
+  return get<Array>(_value, "an array");
+}
+
+auto Json::as_object() const -> Object const & {
+  return get<Object>(_value, "an object");
+}
+
+auto Json::operator[](std::string_view key) const -> Json const & {
+  static Json const null{};
+  if (auto const *object{std::get_if<Object>(&_value)}) {
+    for (auto const &[name, value] : *object) {
+      if (name == key) {
+        return value;
+      }
+    }
+  }
+  return null;
+}
+
+// _____________________________________________________________________________
+
+auto quoted(std::string_view text) -> std::string {
+  std::string string{'"'};
+  for (auto c : text) {
+    switch (c) {
+    case '"':
+      string += "\\\"";
+      break;
+    case '\\':
+      string += "\\\\";
+      break;
+    case '\n':
+      string += "\\n";
+      break;
+    case '\t':
+      string += "\\t";
+      break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x20) {
+        char escaped[7];
+        std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+        string += escaped;
+      } else {
+        string += c;
+      }
+    }
+  }
+  string += '"';
+  return string;
+}
+
+} // namespace runtime
@@ -0,0 +1,58 @@
+#ifndef json_h
+#define json_h
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace runtime {
+
+// _____________________________________________________________________________
+// JSON
+// Just enough JSON to read back the result files written by the executables
+
+class Json {
+public:
+  using Array = std::vector<Json>;
+  using Object = std::vector<std::pair<std::string, Json>>;
+
+  Json() = default;
+  Json(std::nullptr_t) {}
+  Json(bool value) : _value{value} {}
+  Json(double value) : _value{value} {}
+  Json(char const *value) : _value{std::string{value}} {}
+  Json(std::string value) : _value{std::move(value)} {}
+  Json(Array value) : _value{std::move(value)} {}
+  Json(Object value) : _value{std::move(value)} {}
+
+  // Throws std::invalid_argument on malformed input
+  static auto parse(std::string_view text) -> Json;
+
+  auto is_null() const -> bool {
+    return std::holds_alternative<std::nullptr_t>(_value);
+  }
+
+  // Throw std::invalid_argument if the value has another type
+  auto as_bool() const -> bool;
+  auto as_number() const -> double;
+  auto as_string() const -> std::string const &;
+  auto as_array() const -> Array const &;
+  auto as_object() const -> Object const &;
+
+  // Member of an object, null if absent
+  auto operator[](std::string_view key) const -> Json const &;
+
+private:
+  std::variant<std::nullptr_t, bool, double, std::string, Array, Object>
+      _value{nullptr};
+};
+
+// Quoted and escaped string literal
+auto quoted(std::string_view text) -> std::string;
+
+} // namespace runtime
+
+#endif
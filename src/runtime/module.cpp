@@ -0,0 +1,25 @@
+#include "module.h"
+#include <algorithm>
+
+namespace runtime {
+
+// Function-local to be usable during static initialization
+auto registered_modules() -> std::vector<Module> & {
+  static std::vector<Module> modules{};
+  return modules;
+}
+
+auto modules() -> std::vector<Module> const & { return registered_modules(); }
+
+ModuleRegistrar::ModuleRegistrar(std::string_view name, auto (*run)()->void,
+                                 std::source_location location) {
+  auto &modules{registered_modules()};
+  Module entry{name, location.file_name(), run};
+  auto position{std::upper_bound(modules.begin(), modules.end(), entry,
+                                 [](Module const &lhs, Module const &rhs) {
+                                   return lhs.file < rhs.file;
+                                 })};
+  modules.insert(position, entry);
+}
+
+} // namespace runtime
@@ -0,0 +1,34 @@
+#ifndef module_h
+#define module_h
+
+#include <source_location>
+#include <string_view>
+#include <vector>
+
+namespace runtime {
+
+// _____________________________________________________________________________
+// Module
+// A namespace whose `run()` exercises the examples of one source file.
+// Modules register themselves during static initialization, so adding a
+// source file is enough to make it part of the executable
+
+struct Module {
+  std::string_view name;
+  std::string_view file;
+  auto (*run)() -> void;
+};
+
+// Registered modules, ordered by source file
+auto modules() -> std::vector<Module> const &;
+
+class ModuleRegistrar {
+public:
+  ModuleRegistrar(
+      std::string_view name, auto (*run)()->void,
+      std::source_location location = std::source_location::current());
+};
+
+} // namespace runtime
+
+#endif
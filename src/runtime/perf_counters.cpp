@@ -0,0 +1,227 @@
+#include "perf_counters.h"
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace runtime {
+
+// _____________________________________________________________________________
+// Readings
+
+auto CounterReadings::ipc() const -> std::optional<double> {
+  auto const &cycles{(*this)[Event::cycles]};
+  auto const &instructions{(*this)[Event::instructions]};
+  if (!cycles || !instructions || *cycles == 0) {
+    return std::nullopt;
+  }
+  return *instructions / *cycles;
+}
+
+auto CounterReadings::divided_by(double divisor) const -> CounterReadings {
+  CounterReadings readings{*this};
+  for (auto &value : readings.values) {
+    if (value) {
+      *value /= divisor;
+    }
+  }
+  return readings;
+}
+
+// _____________________________________________________________________________
+// Counters
+
+#if defined(__linux__)
+
+struct EventConfig {
+  std::uint32_t type;
+  std::uint64_t config;
+};
+
+constexpr auto cache_miss(std::uint64_t cache) -> std::uint64_t {
+  return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+         (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+constexpr std::array<EventConfig, event_count> event_configs{{
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_L1D)},
+    {PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_LL)},
+    {PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_DTLB)},
+}};
+
+auto open_event(EventConfig const &event) -> int {
+  perf_event_attr attributes{};
+  attributes.size = sizeof(attributes);
+  attributes.type = event.type;
+  attributes.config = event.config;
+  attributes.disabled = 1;
+  attributes.exclude_kernel = 1;
+  attributes.exclude_hv = 1;
+  attributes.read_format =
+      PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  // Calling thread, any CPU
+  return static_cast<int>(
+      syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+}
+
+PerfCounters::PerfCounters() {
+  for (std::size_t i{0}; i < event_count; ++i) {
+    _descriptors[i] = open_event(event_configs[i]);
+  }
+}
+
+PerfCounters::~PerfCounters() {
+  for (auto descriptor : _descriptors) {
+    if (descriptor >= 0) {
+      close(descriptor);
+    }
+  }
+}
+
+auto PerfCounters::available() const -> bool {
+  for (auto descriptor : _descriptors) {
+    if (descriptor >= 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+auto PerfCounters::start() -> void {
+  for (auto descriptor : _descriptors) {
+    if (descriptor >= 0) {
+      ioctl(descriptor, PERF_EVENT_IOC_RESET, 0);
+      ioctl(descriptor, PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+}
+
+auto PerfCounters::pause() -> void {
+  for (auto descriptor : _descriptors) {
+    if (descriptor >= 0) {
+      ioctl(descriptor, PERF_EVENT_IOC_DISABLE, 0);
+    }
+  }
+}
+
+auto PerfCounters::resume() -> void {
+  for (auto descriptor : _descriptors) {
+    if (descriptor >= 0) {
+      ioctl(descriptor, PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+}
+
+auto PerfCounters::stop() -> CounterReadings {
+  pause();
+  CounterReadings readings{};
+  for (std::size_t i{0}; i < event_count; ++i) {
+    // value, time enabled, time running
+    std::uint64_t data[3]{};
+    if (_descriptors[i] < 0 ||
+        read(_descriptors[i], data, sizeof(data)) != sizeof(data) ||
+        data[2] == 0) {
+      continue;
+    }
+    readings.values[i] = static_cast<double>(data[0]) *
+                         static_cast<double>(data[1]) /
+                         static_cast<double>(data[2]);
+  }
+  return readings;
+}
+
+auto counters_unavailable_reason() -> std::string {
+  PerfCounters counters{};
+  auto const error{errno}; // of the last failed open
+  if (counters.available()) {
+    return "";
+  }
+  std::ostringstream reason;
+  reason << "hardware counters unavailable: " << std::strerror(error);
+  std::ifstream paranoid{"/proc/sys/kernel/perf_event_paranoid"};
+  if (int level{}; paranoid >> level) {
+    reason << " (perf_event_paranoid=" << level << ')';
+  }
+  return reason.str();
+}
+
+#else
+
+PerfCounters::PerfCounters() { _descriptors.fill(-1); }
+PerfCounters::~PerfCounters() {}
+auto PerfCounters::available() const -> bool { return false; }
+auto PerfCounters::start() -> void {}
+auto PerfCounters::pause() -> void {}
+auto PerfCounters::resume() -> void {}
+auto PerfCounters::stop() -> CounterReadings { return {}; }
+
+auto counters_unavailable_reason() -> std::string {
+  return "hardware counters unavailable: not supported on this platform";
+}
+
+#endif
+
+// _____________________________________________________________________________
+// Formatting
+
+// Abbreviates large counts: 1234567 -> 1.23M
+auto format_count(std::optional<double> const &count) -> std::string {
+  if (!count) {
+    return "-";
+  }
+  std::ostringstream os;
+  os << std::fixed << std::setprecision(2);
+  auto const value{*count};
+  if (value >= 1e9) {
+    os << value / 1e9 << 'G';
+  } else if (value >= 1e6) {
+    os << value / 1e6 << 'M';
+  } else if (value >= 1e3) {
+    os << value / 1e3 << 'k';
+  } else {
+    os << value;
+  }
+  return os.str();
+}
+
+auto format_ratio(std::optional<double> const &ratio) -> std::string {
+  if (!ratio) {
+    return "-";
+  }
+  std::ostringstream os;
+  os << std::fixed << std::setprecision(2) << *ratio;
+  return os.str();
+}
+
+auto counters_header() -> std::string {
+  std::ostringstream os;
+  os << std::setw(10) << "cycles" << std::setw(7) << "IPC" << std::setw(10)
+     << "br-miss" << std::setw(10) << "L1d-miss" << std::setw(10)
+     << "LLC-miss" << std::setw(10) << "dTLB-miss";
+  return os.str();
+}
+
+auto format_counters(CounterReadings const &readings) -> std::string {
+  std::ostringstream os;
+  os << std::setw(10) << format_count(readings[Event::cycles]) << std::setw(7)
+     << format_ratio(readings.ipc()) << std::setw(10)
+     << format_count(readings[Event::branch_misses])
+     << std::setw(10) << format_count(readings[Event::l1d_misses])
+     << std::setw(10) << format_count(readings[Event::llc_misses])
+     << std::setw(10) << format_count(readings[Event::dtlb_misses]);
+  return os.str();
+}
+
+} // namespace runtime
@@ -0,0 +1,81 @@
+#ifndef perf_counters_h
+#define perf_counters_h
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace runtime {
+
+// _____________________________________________________________________________
+// Hardware performance counters
+// Linux perf events counting user-space activity of the calling thread.
+// Events the kernel refuses (no PMU in containers and virtual machines,
+// restrictive perf_event_paranoid, other platforms) read as unavailable
+
+enum class Event {
+  cycles,
+  instructions,
+  branch_misses,
+  l1d_misses,
+  llc_misses,
+  dtlb_misses,
+};
+
+inline constexpr std::size_t event_count{6};
+
+inline constexpr std::array<std::string_view, event_count> event_names{
+    "cycles",     "instructions", "branch-misses",
+    "L1d-misses", "LLC-misses",   "dTLB-misses"};
+
+struct CounterReadings {
+  std::array<std::optional<double>, event_count> values{};
+
+  auto operator[](Event event) const -> std::optional<double> const & {
+    return values[static_cast<std::size_t>(event)];
+  }
+
+  // Instructions per cycle
+  auto ipc() const -> std::optional<double>;
+
+  auto divided_by(double divisor) const -> CounterReadings;
+};
+
+class PerfCounters {
+public:
+  // Opens the counters of the calling thread, disabled
+  PerfCounters();
+
+  ~PerfCounters();
+
+  PerfCounters(PerfCounters const &) = delete;
+  PerfCounters &operator=(PerfCounters const &) = delete;
+
+  auto available() const -> bool;
+
+  // Resets and enables the counters
+  auto start() -> void;
+
+  // Disables and reads the counters, scaled for multiplexing
+  auto stop() -> CounterReadings;
+
+  // Suspend counting without resetting
+  auto pause() -> void;
+  auto resume() -> void;
+
+private:
+  std::array<int, event_count> _descriptors{};
+};
+
+// Why the counters are unavailable, empty if at least one event can be opened
+auto counters_unavailable_reason() -> std::string;
+
+// Fixed-width columns: cycles, IPC and the miss counts
+auto counters_header() -> std::string;
+auto format_counters(CounterReadings const &readings) -> std::string;
+
+} // namespace runtime
+
+#endif
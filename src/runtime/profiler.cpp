@@ -0,0 +1,194 @@
+#include "profiler.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <signal.h>
+#include <sys/time.h>
+
+namespace runtime {
+
+// _____________________________________________________________________________
+// Options
+
+auto ProfilerOptions::parse(Arguments &arguments) -> ProfilerOptions {
+  ProfilerOptions options{};
+  options.path = arguments.value("--profile").value_or("");
+  if (auto frequency{arguments.number("--profile-hz")}) {
+    if (*frequency == 0 || *frequency > 100'000) {
+      throw std::invalid_argument{"--profile-hz must be in [1, 100000]"};
+    }
+    options.frequency = static_cast<unsigned>(*frequency);
+  }
+  return options;
+}
+
+// _____________________________________________________________________________
+// Sampling
+
+inline constexpr int max_depth{64};
+inline constexpr std::size_t capacity{1 << 14};
+// The signal handler and the signal trampoline
+inline constexpr int skipped_frames{2};
+
+struct StackSample {
+  void *frames[max_depth];
+  // Published last: 0 while the frames are being written
+  std::atomic<int> depth;
+};
+
+struct Profile {
+  std::unique_ptr<StackSample[]> samples{};
+  // Claimed slots, may exceed the capacity when samples are dropped
+  std::atomic<std::size_t> next{};
+  std::ofstream file{};
+};
+
+// Set once before the timer starts, the handler must not initialize anything
+Profile *active_profile{nullptr};
+
+extern "C" auto on_profiling_signal(int) -> void {
+  auto const saved_errno{errno};
+  auto &profile{*active_profile};
+  auto const index{profile.next.fetch_add(1, std::memory_order_relaxed)};
+  if (index < capacity) {
+    auto &sample{profile.samples[index]};
+    // Not async-signal-safe in general, but lock-free once the unwinder is
+    // loaded and, with glibc 2.35 and later, registered objects are looked up
+    // without taking the loader lock
+    auto const depth{backtrace(sample.frames, max_depth)};
+    sample.depth.store(depth, std::memory_order_release);
+  }
+  errno = saved_errno;
+}
+
+// _____________________________________________________________________________
+// Symbolization
+
+auto symbol_name(void *address, bool return_address) -> std::string {
+  // A return address may belong to the next function when the call is the
+  // last instruction of the caller
+  auto const lookup{static_cast<char *>(address) - (return_address ? 1 : 0)};
+  Dl_info info{};
+  if (dladdr(lookup, &info) == 0) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%p", address);
+    return buffer;
+  }
+  if (info.dli_sname) {
+    auto status{0};
+    std::unique_ptr<char, decltype(&std::free)> const demangled{
+        abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status),
+        &std::free};
+    return status == 0 ? demangled.get() : info.dli_sname;
+  }
+  // Static functions and executables without exported symbols
+  std::string object{info.dli_fname ? info.dli_fname : "?"};
+  object = object.substr(object.rfind('/') + 1);
+  char offset[32];
+  std::snprintf(offset, sizeof(offset), "+%#tx",
+                lookup - static_cast<char *>(info.dli_fbase));
+  return object + offset;
+}
+
+auto write_profile() -> void {
+  itimerval const stop{};
+  setitimer(ITIMER_PROF, &stop, nullptr);
+  signal(SIGPROF, SIG_IGN);
+
+  auto &profile{*active_profile};
+  auto const taken{profile.next.load()};
+  std::unordered_map<void *, std::string> symbols{};
+  auto symbol = [&](void *address, bool return_address) -> auto const & {
+    auto [it, inserted]{symbols.try_emplace(address)};
+    if (inserted) {
+      it->second = symbol_name(address, return_address);
+      // Separators of the format
+      for (auto &c : it->second) {
+        c = c == ';' ? ':' : c;
+      }
+    }
+    return it->second;
+  };
+
+  std::map<std::string, std::size_t> stacks{};
+  for (std::size_t i{0}; i < std::min(taken, capacity); ++i) {
+    auto const &sample{profile.samples[i]};
+    auto const depth{sample.depth.load(std::memory_order_acquire)};
+    if (depth <= skipped_frames) {
+      continue;
+    }
+    // Root first; the innermost frame is the interrupted instruction itself
+    std::string stack{};
+    for (auto frame{depth - 1}; frame >= skipped_frames; --frame) {
+      if (!stack.empty()) {
+        stack += ';';
+      }
+      stack += symbol(sample.frames[frame], frame != skipped_frames);
+    }
+    ++stacks[stack];
+  }
+
+  for (auto const &[stack, count] : stacks) {
+    profile.file << stack << ' ' << count << '\n';
+  }
+  profile.file.close();
+  if (!profile.file) {
+    std::cerr << "cannot write the profile\n";
+  }
+  if (taken > capacity) {
+    std::cerr << "profile: " << taken - capacity << " of " << taken
+              << " samples dropped, lower --profile-hz\n";
+  }
+}
+
+// _____________________________________________________________________________
+
+auto start_profiler(ProfilerOptions const &options) -> void {
+  if (options.path.empty()) {
+    return;
+  }
+  static Profile profile{};
+  profile.file.open(options.path);
+  if (!profile.file) {
+    throw std::runtime_error{"cannot write " + options.path};
+  }
+  profile.samples = std::make_unique<StackSample[]>(capacity);
+  active_profile = &profile;
+
+  // The first call loads the unwinder, which allocates
+  void *frames[1];
+  backtrace(frames, 1);
+
+  struct sigaction action{};
+  action.sa_handler = on_profiling_signal;
+  action.sa_flags = SA_RESTART;
+  sigemptyset(&action.sa_mask);
+  if (sigaction(SIGPROF, &action, nullptr) != 0) {
+    throw std::runtime_error{std::string{"sigaction: "} +
+                             std::strerror(errno)};
+  }
+  std::atexit(write_profile);
+
+  auto const period{1'000'000 / options.frequency};
+  itimerval const timer{{0, static_cast<suseconds_t>(period)},
+                        {0, static_cast<suseconds_t>(period)}};
+  if (setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+    throw std::runtime_error{std::string{"setitimer: "} +
+                             std::strerror(errno)};
+  }
+}
+
+} // namespace runtime
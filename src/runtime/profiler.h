@@ -0,0 +1,33 @@
+#ifndef profiler_h
+#define profiler_h
+
+#include "arguments.h"
+#include <string>
+
+namespace runtime {
+
+// _____________________________________________________________________________
+// Sampling profiler
+// A profiling timer interrupts the process every 1/frequency seconds of CPU
+// time; the signal handler stores the call stack of the interrupted thread in
+// a preallocated buffer. At exit the stacks are symbolized and written as
+// folded stacks, one `caller;callee count` line per distinct stack, the input
+// of flamegraph.pl and speedscope. Symbols of the executable require it to be
+// linked with exported symbols (ENABLE_EXPORTS)
+
+struct ProfilerOptions {
+  // No profiling if empty
+  std::string path{};
+  // Samples per second of CPU time, prime so as not to beat with periodic work
+  unsigned frequency{997};
+
+  // Consumes `--profile <file>` and `--profile-hz <n>`
+  static auto parse(Arguments &arguments) -> ProfilerOptions;
+};
+
+// Starts sampling, the profile is written at exit
+auto start_profiler(ProfilerOptions const &options) -> void;
+
+} // namespace runtime
+
+#endif
@@ -0,0 +1,138 @@
+#include "runner.h"
+#include "thread_pool.h"
+#include "trace.h"
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <ranges>
+#include <stdexcept>
+#include <thread>
+
+namespace runtime {
+
+using Clock = std::chrono::steady_clock;
+
+// _____________________________________________________________________________
+
+auto RunnerOptions::parse(Arguments &arguments) -> RunnerOptions {
+  RunnerOptions options{};
+  options.jobs = std::max(1u, std::thread::hardware_concurrency());
+
+  if (auto filter{arguments.value("--filter")}) {
+    for (auto pattern : std::views::split(*filter, ',')) {
+      options.filters.emplace_back(pattern.begin(), pattern.end());
+    }
+  }
+  if (auto jobs{arguments.number("--jobs")}) {
+    if (*jobs == 0) {
+      throw std::invalid_argument{"--jobs must be positive"};
+    }
+    options.jobs = static_cast<unsigned>(*jobs);
+  }
+  options.counters = arguments.flag("--counters");
+  return options;
+}
+
+auto selected(RunnerOptions const &options, std::string_view name) -> bool {
+  return options.filters.empty() ||
+         std::ranges::any_of(options.filters, [&](std::string const &filter) {
+           return name.find(filter) != std::string_view::npos;
+         });
+}
+
+// _____________________________________________________________________________
+
+auto run_modules(RunnerOptions const &options) -> RunReport {
+  RunReport report{};
+  for (auto const &module : modules()) {
+    if (selected(options, module.name)) {
+      report.modules.push_back({&module});
+    }
+  }
+  report.jobs = std::min<unsigned>(
+      options.jobs, std::max<std::size_t>(report.modules.size(), 1));
+
+  auto counters{options.counters};
+  if (counters) {
+    if (auto reason{counters_unavailable_reason()}; !reason.empty()) {
+      report.notes.push_back(std::move(reason));
+      counters = false;
+    }
+  }
+
+  ThreadPool pool{report.jobs};
+  std::atomic<unsigned> running{0};
+  TRACE_SCOPE("run_modules");
+  auto const start{Clock::now()};
+  pool.parallel_for(report.modules.size(), [&](std::size_t i) {
+    auto &result{report.modules[i]};
+    trace_counter("running modules", ++running);
+    // Counters follow the thread executing the module
+    std::optional<PerfCounters> thread_counters{};
+    if (counters) {
+      thread_counters.emplace();
+      thread_counters->start();
+    }
+    AllocationScope const allocations{};
+    auto const module_start{Clock::now()};
+    {
+      TRACE_SCOPE(result.module->name);
+      result.module->run();
+    }
+    result.wall = Clock::now() - module_start;
+    if constexpr (allocation_tracking) {
+      result.allocations = allocations.stop();
+    }
+    if (thread_counters) {
+      result.counters = thread_counters->stop();
+    }
+    trace_counter("running modules", --running);
+  });
+  report.wall = Clock::now() - start;
+  report.peak_rss = peak_rss();
+  return report;
+}
+
+// _____________________________________________________________________________
+
+auto milliseconds(std::chrono::nanoseconds duration) -> double {
+  return std::chrono::duration<double, std::milli>{duration}.count();
+}
+
+auto print_report(std::ostream &os, RunReport const &report) -> void {
+  auto const flags{os.flags()};
+  auto const counters{std::ranges::any_of(
+      report.modules,
+      [](auto const &result) { return result.counters.has_value(); })};
+  auto const allocations{std::ranges::any_of(
+      report.modules,
+      [](auto const &result) { return result.allocations.has_value(); })};
+
+  os << std::left << std::setw(24) << "module" << std::right << std::setw(12)
+     << "wall [ms]" << (allocations ? allocations_header() : "")
+     << (counters ? counters_header() : "") << '\n';
+  os << std::fixed << std::setprecision(3);
+  for (auto const &result : report.modules) {
+    os << std::left << std::setw(24) << result.module->name << std::right
+       << std::setw(12) << milliseconds(result.wall);
+    if (result.allocations) {
+      os << format_allocations(*result.allocations);
+    }
+    if (result.counters) {
+      os << format_counters(*result.counters);
+    }
+    os << '\n';
+  }
+  os << report.modules.size() << " modules, " << report.jobs << " jobs, "
+     << milliseconds(report.wall) << " ms";
+  if (report.peak_rss) {
+    os << ", peak RSS " << format_bytes(*report.peak_rss);
+  }
+  os << '\n';
+  for (auto const &note : report.notes) {
+    os << note << '\n';
+  }
+  os.flags(flags);
+}
+
+} // namespace runtime
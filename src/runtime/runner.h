@@ -0,0 +1,56 @@
+#ifndef runner_h
+#define runner_h
+
+#include "allocations.h"
+#include "arguments.h"
+#include "module.h"
+#include "perf_counters.h"
+#include <chrono>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace runtime {
+
+// _____________________________________________________________________________
+// Module runner
+// Executes the registered modules concurrently on a thread pool and measures
+// the wall time of each one, and its heap allocations when they are tracked
+
+struct RunnerOptions {
+  // Comma-separated substrings; a module runs if its name contains any of them
+  std::vector<std::string> filters{};
+  unsigned jobs{1};
+  // Hardware counters around each module
+  bool counters{false};
+
+  // Consumes `--filter <patterns>`, `--jobs <n>` and `--counters`
+  static auto parse(Arguments &arguments) -> RunnerOptions;
+};
+
+struct ModuleResult {
+  Module const *module{nullptr};
+  std::chrono::nanoseconds wall{};
+  std::optional<CounterReadings> counters{};
+  std::optional<AllocationStats> allocations{};
+};
+
+struct RunReport {
+  std::vector<ModuleResult> modules{};
+  std::chrono::nanoseconds wall{};
+  unsigned jobs{};
+  std::optional<std::size_t> peak_rss{};
+  // Why requested measurements are missing
+  std::vector<std::string> notes{};
+};
+
+auto selected(RunnerOptions const &options, std::string_view name) -> bool;
+
+auto run_modules(RunnerOptions const &options) -> RunReport;
+
+auto print_report(std::ostream &os, RunReport const &report) -> void;
+
+} // namespace runtime
+
+#endif
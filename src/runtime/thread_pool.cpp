@@ -0,0 +1,118 @@
+#include "thread_pool.h"
+#include <utility>
+
+namespace runtime {
+
+// Loops the current thread is executing, innermost first: a thread inside
+// the loop of a pool can run the loop of another one
+struct Executing {
+  ThreadPool const *pool;
+  Executing const *outer;
+};
+
+thread_local Executing const *executing{nullptr};
+
+auto is_executing(ThreadPool const *pool) -> bool {
+  for (auto const *loop{executing}; loop != nullptr; loop = loop->outer) {
+    if (loop->pool == pool) {
+      return true;
+    }
+  }
+  return false;
+}
+
+ThreadPool::ThreadPool(unsigned threads) {
+  for (unsigned i{1}; i < threads; ++i) {
+    _workers.emplace_back([this] { work(); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard lock{_mutex};
+    _stop = true;
+  }
+  _wake.notify_all();
+  for (auto &worker : _workers) {
+    worker.join();
+  }
+}
+
+auto ThreadPool::parallel_for(std::size_t count,
+                              std::function<void(std::size_t)> const &body)
+    -> void {
+  if (is_executing(this) || _workers.empty() || count < 2) {
+    for (std::size_t i{0}; i < count; ++i) {
+      body(i);
+    }
+    return;
+  }
+
+  std::lock_guard submit{_submit};
+  {
+    std::unique_lock lock{_mutex};
+    _idle.wait(lock, [this] { return _active == 0; });
+    _body = &body;
+    _count = count;
+    _next.store(0, std::memory_order_relaxed);
+    _error = nullptr;
+    ++_generation;
+    ++_active;
+  }
+  _wake.notify_all();
+
+  execute();
+
+  std::unique_lock lock{_mutex};
+  _idle.wait(lock, [this] { return _active == 0; });
+  _body = nullptr;
+  if (auto error{std::exchange(_error, nullptr)}) {
+    std::rethrow_exception(error);
+  }
+}
+
+auto ThreadPool::work() -> void {
+  auto seen{0ul};
+  std::unique_lock lock{_mutex};
+  while (true) {
+    _wake.wait(lock, [&] { return _stop || _generation != seen; });
+    if (_stop) {
+      return;
+    }
+    seen = _generation;
+    ++_active;
+    lock.unlock();
+    execute();
+    lock.lock();
+  }
+}
+
+auto ThreadPool::execute() -> void {
+  Executing const loop{this, executing};
+  executing = &loop;
+  for (auto i{_next.fetch_add(1, std::memory_order_relaxed)}; i < _count;
+       i = _next.fetch_add(1, std::memory_order_relaxed)) {
+    try {
+      (*_body)(i);
+    } catch (...) {
+      std::lock_guard lock{_mutex};
+      if (!_error) {
+        _error = std::current_exception();
+      }
+      _next.store(_count, std::memory_order_relaxed);
+    }
+  }
+  executing = loop.outer;
+
+  std::lock_guard lock{_mutex};
+  if (--_active == 0) {
+    _idle.notify_all();
+  }
+}
+
+auto default_pool() -> ThreadPool & {
+  static ThreadPool pool{};
+  return pool;
+}
+
+} // namespace runtime
@@ -0,0 +1,67 @@
+#ifndef thread_pool_h
+#define thread_pool_h
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace runtime {
+
+// _____________________________________________________________________________
+// Thread pool
+// A fixed set of workers executing the iterations of one parallel loop at a
+// time. The calling thread takes part in the loop, so a pool of `threads`
+// spawns `threads - 1` workers
+
+class ThreadPool {
+public:
+  explicit ThreadPool(unsigned threads = std::thread::hardware_concurrency());
+
+  ~ThreadPool();
+
+  ThreadPool(ThreadPool const &) = delete;
+  ThreadPool &operator=(ThreadPool const &) = delete;
+
+  auto size() const -> unsigned {
+    return static_cast<unsigned>(_workers.size()) + 1;
+  }
+
+  // Calls `body(i)` for every i in [0, count) and waits for completion.
+  // The first exception thrown by `body` is rethrown on the calling thread.
+  // A call from inside the loop of the same pool, which would wait for
+  // itself, runs serially on the current thread; a call on another pool
+  // runs in parallel
+  auto parallel_for(std::size_t count,
+                    std::function<void(std::size_t)> const &body) -> void;
+
+private:
+  std::vector<std::thread> _workers;
+  std::mutex _submit;
+  std::mutex _mutex;
+  std::condition_variable _wake;
+  std::condition_variable _idle;
+
+  // Current loop, published under `_mutex` while no worker is active
+  std::function<void(std::size_t)> const *_body{nullptr};
+  std::size_t _count{};
+  std::atomic<std::size_t> _next{};
+  std::exception_ptr _error{};
+  unsigned _active{};
+  unsigned long _generation{};
+  bool _stop{false};
+
+  auto work() -> void;
+  auto execute() -> void;
+};
+
+// Pool shared by the parallel algorithms of the project
+auto default_pool() -> ThreadPool &;
+
+} // namespace runtime
+
+#endif
@@ -0,0 +1,143 @@
+#include "trace.h"
+#include "json.h"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace runtime {
+
+// _____________________________________________________________________________
+// Buffers
+
+struct TraceEvent {
+  std::string_view name;
+  char phase; // 'X': complete span, 'C': counter
+  std::int64_t timestamp;
+  double value; // duration in nanoseconds or counter value
+};
+
+struct ThreadBuffer {
+  unsigned id;
+  std::vector<TraceEvent> events{};
+};
+
+struct TraceRegistry {
+  std::mutex mutex;
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers{};
+  std::ofstream file{};
+  std::int64_t origin{};
+};
+
+auto trace_registry() -> TraceRegistry & {
+  static TraceRegistry registry{};
+  return registry;
+}
+
+// The registry owns the buffers, so that the events of threads that have
+// already exited are still written
+auto thread_buffer() -> ThreadBuffer & {
+  thread_local ThreadBuffer *buffer{nullptr};
+  if (!buffer) [[unlikely]] {
+    auto &registry{trace_registry()};
+    std::lock_guard const lock{registry.mutex};
+    auto const id{static_cast<unsigned>(registry.buffers.size()) + 1};
+    registry.buffers.push_back(
+        std::make_unique<ThreadBuffer>(ThreadBuffer{id}));
+    buffer = registry.buffers.back().get();
+    buffer->events.reserve(1024);
+  }
+  return *buffer;
+}
+
+auto record_span(std::string_view name, std::int64_t start, std::int64_t end)
+    -> void {
+  thread_buffer().events.push_back(
+      {name, 'X', start, static_cast<double>(end - start)});
+}
+
+auto trace_counter(std::string_view name, double value) -> void {
+  if (tracing.load(std::memory_order_relaxed)) {
+    thread_buffer().events.push_back({name, 'C', trace_clock(), value});
+  }
+}
+
+// _____________________________________________________________________________
+// Output
+
+// "void ns::function(int)" -> "ns::function"
+auto display_name(std::string_view name) -> std::string_view {
+  auto const parenthesis{name.find('(')};
+  if (parenthesis == std::string_view::npos) {
+    return name;
+  }
+  name = name.substr(0, parenthesis);
+  auto const space{name.rfind(' ')};
+  return space == std::string_view::npos ? name : name.substr(space + 1);
+}
+
+// Microseconds, the unit of the format
+auto microseconds(double nanoseconds) -> std::string {
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%.3f", nanoseconds / 1e3);
+  return buffer;
+}
+
+auto write_trace(std::ostream &os, TraceRegistry const &registry) -> void {
+  os << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+  auto separator{"\n"};
+  for (auto const &buffer : registry.buffers) {
+    os << separator << "{\"name\": \"thread_name\", \"ph\": \"M\", "
+       << "\"pid\": 1, \"tid\": " << buffer->id << ", \"args\": {\"name\": "
+       << quoted(buffer->id == 1 ? "main" : "thread " +
+                                                std::to_string(buffer->id))
+       << "}}";
+    separator = ",\n";
+    for (auto const &event : buffer->events) {
+      auto const timestamp{event.timestamp - registry.origin};
+      os << separator << "{\"name\": " << quoted(display_name(event.name))
+         << ", \"ph\": \"" << event.phase << "\", \"pid\": 1, \"tid\": "
+         << buffer->id
+         << ", \"ts\": " << microseconds(static_cast<double>(timestamp));
+      if (event.phase == 'X') {
+        os << ", \"dur\": " << microseconds(event.value) << '}';
+      } else {
+        os << ", \"args\": {\"value\": " << event.value << "}}";
+      }
+    }
+  }
+  os << "\n]}\n";
+}
+
+auto flush_trace() -> void {
+  tracing.store(false);
+  auto &registry{trace_registry()};
+  std::lock_guard const lock{registry.mutex};
+  write_trace(registry.file, registry);
+  registry.file.close();
+  if (!registry.file) {
+    std::cerr << "cannot write the trace\n";
+  }
+}
+
+// _____________________________________________________________________________
+
+auto start_tracing(std::string const &path) -> void {
+  // Constructed before registering the handler, hence destroyed after it runs
+  auto &registry{trace_registry()};
+  registry.file.open(path);
+  if (!registry.file) {
+    throw std::runtime_error{"cannot write " + path};
+  }
+  registry.origin = trace_clock();
+  // The calling thread is listed first
+  thread_buffer();
+  std::atexit(flush_trace);
+  tracing.store(true);
+}
+
+} // namespace runtime
@@ -0,0 +1,72 @@
+#ifndef trace_h
+#define trace_h
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <source_location>
+#include <string>
+#include <string_view>
+
+namespace runtime {
+
+// _____________________________________________________________________________
+// Tracing
+// Scoped spans and counters in the Chrome trace-event format, viewable in
+// chrome://tracing or ui.perfetto.dev. Every thread records into its own
+// buffer without locking; the buffers are written when the program exits.
+// Names are not copied and must outlive the trace (string literals, function
+// names, module names)
+
+// Set while a trace is being recorded
+inline std::atomic<bool> tracing{false};
+
+inline auto trace_clock() -> std::int64_t {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// Starts recording, the trace is written to `path` at exit
+auto start_tracing(std::string const &path) -> void;
+
+auto record_span(std::string_view name, std::int64_t start, std::int64_t end)
+    -> void;
+
+// Samples a value plotted over time, e.g. a queue length
+auto trace_counter(std::string_view name, double value) -> void;
+
+class Span {
+public:
+  explicit Span(std::string_view name)
+      : _name{name},
+        _start{tracing.load(std::memory_order_relaxed) ? trace_clock() : -1} {}
+
+  ~Span() {
+    if (_start >= 0) {
+      record_span(_name, _start, trace_clock());
+    }
+  }
+
+  Span(Span const &) = delete;
+  Span &operator=(Span const &) = delete;
+
+private:
+  std::string_view _name;
+  std::int64_t _start;
+};
+
+} // namespace runtime
+
+#define TRACE_CONCAT_IMPL(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_IMPL(a, b)
+
+// Span named `name` up to the end of the enclosing scope
+#define TRACE_SCOPE(name)                                                      \
+  runtime::Span const TRACE_CONCAT(trace_span_, __LINE__) { name }
+
+// Span named after the enclosing function
+#define TRACE_FUNCTION()                                                       \
+  TRACE_SCOPE(std::source_location::current().function_name())
+
+#endif